@@ -1,276 +1,376 @@
-#include <iostream>
-#include <vector>
-#include <fstream>
-#include <sstream>
-#include <cctype>
-#include "tree.h"
-#include "date.h"
-/* This program asserts the probable outcome of a certain football match using a decision tree.
- * Using a data table and a query passed in via the command line, all historical precedents of the
- * conditions associated with that match are used to form a decision tree and produce an outcome.*/
-
-std::string string_replace(const std::string& a, char replace, char new_char){
-/* This is a utility function to remove spaces for entries in the table*/
-std::string ret="";
-for(int i=0;i<a.size();i++){
-	if(a[i] == replace){
-		ret+= new_char;
-	}
-	else{
-		ret+=a[i];
-	};
-};
-return ret;
-}
-
-
-void format_data(const std::string team_a, const std::string team_b,
-		std::ifstream& inFile,
-		std::vector<std::string>& conditions, std::vector<std::vector<std::string> >& data,
-		const Date& starting_year){
-	/*This function formats all the data in the data file to produce a data table of strings that can
-	 * later be used to identify appropriate matchups and conditions for the query match. The way this 
-	 * function specifically stores the data is based on an expected structure of the data file.*/
-	std::string first_line;
-	inFile >> first_line;
-	std::string condition="";
-	for(int i=0;i<first_line.length();i++){
-	/*The first line holds the generic conditions that describes the data; store those first.*/
-		if(first_line[i] ==','){
-			conditions.push_back(condition);
-			condition = "";
-		}
-		else{
-			condition+=first_line[i];
-		};
-	};
-	std::vector<std::string> current_line;
-	char sub;
-	std::string curr_string;
-	while(std::getline(inFile,curr_string)){
-	if(curr_string.length()==0){
-		continue;
-		};
-	std::string term="";
-	for(int i=0;i<curr_string.length();i++){
-		/*Each entry in row separated by a comma*/
-		if(curr_string[i] ==','){
-			current_line.push_back(string_replace(term,' ','_'));
-			term = "";
-		}
-		else{
-			term+=curr_string[i];
-		};
-	};	
-	current_line.push_back(string_replace(term,' ','_'));
-	//need to check if valid date in range
-	std::string date_string = current_line[0];
-	std::string sub = "";
-	std::string date_nums[3];
-	int date_type = 0;
-	for(int i=0;i<date_string.length();i++){
-		if(date_string[i]=='-'){
-			date_nums[date_type] = sub;
-			sub ="";
-			date_type++;
-		}
-		else{
-			sub += date_string[i];
-		};
-	};
-	date_nums[date_type] = sub;
-	int date_ints[3];
-	for(int i=0;i<3;i++){
-		std::stringstream ss;
-		ss << date_nums[i];
-		int sub_date;
-		ss >> sub_date;
-		date_ints[i] = sub_date;
-	};
-	Date date_check(date_ints[2], date_ints[1],date_ints[0]);
-	current_line.push_back(string_replace(term,' ','_'));
-	if(!(date_check < starting_year)){	
-	/* If the date of the match is before the specified starting year, we can add it to
-	 * the data.*/
-	data.push_back(current_line);
-	};
-	current_line.clear();
-	};
-}
-
-void organize_data(std::vector<std::vector<std::string> >& organized_data,
-		const std::vector<std::vector<std::string> >& all_data,
-		const std::string& team_a, const std::string& team_b){
-	/* This function organizes the data into the conditions we want to examine. Specifically for
-	 * football matches pertaining to the given data set, there are a certain set of conditions and 
-	 * an outcome we want to identify. These conditions are the following:
-	 * Home/Away, Tournament Competition?, Neutral Venue
-	 * The outcome we search for is simply Win, Loss, or Draw. Note that this is few conditions, but
-	 * the data file doesn't offer much in the way of specific conditions.*/
-std::vector<std::string> current_line;
-for(int i = 0;i<all_data.size();i++){
-  /*If the match pertains to the two teams we are looking for, store the data.*/
-  if((all_data[i][1]==team_a && all_data[i][2] == team_b)||
-     (all_data[i][1] == team_b && all_data[i][2] == team_a)){
-  std::string outcome;
-  bool a_is_home_team;
-  for(int j=0;j<all_data[i].size();j++){
-	if(j==1){
-		/*The first entry pertains to the home team, where we use team_a, the 
-		 * home team in our query, as our reference.*/ 
-		if(all_data[i][j]==team_a){
-			current_line.push_back("Home");
-			a_is_home_team = true;
-		}
-		else{
-			current_line.push_back("Away");
-			a_is_home_team = false;
-		};
-		j++;
-	}
-	else if(j==3){
-		//Assert scores to determine outcome
-		std::stringstream score_home;
-		std::stringstream score_away;
-		score_home << all_data[i][j];
-		score_away << all_data[i][j+1];
-		//String to int conversion
-		int scoreH;
-		int scoreA;
-		score_home >> scoreH;
-		score_away >> scoreA;
-		std::string margin;
-		if(scoreH > scoreA){
-			/*If team_a is the home team in this instance, then a win
-			 * and vice versa.*/
-			if(a_is_home_team){
-			outcome = "Win";
-			}
-			else{
-			outcome = "Loss";
-			};
-		}
-		else if(scoreH < scoreA){
-			/*If team_a is the home team in this instance, then a loss
-			 * and vice versa.*/
-			if(a_is_home_team){
-			outcome = "Loss";
-			}
-			else{
-			outcome = "Win";
-			};
-		}
-		else{
-			//If the scores are even, then outcome is a draw
-			outcome = "Draw";
-		};
-		j++;
-	}
-	else if(j==5 || j==all_data[i].size()-1){
-		if(j==5){
-			/* The fifth entry pertains to the competition. As teams perform
-			 * different in friendlies than in tournaments, assert whether or not
-			 * game is a friendly (an exhibition) or an official match.*/
-			if(all_data[i][j]!="Friendly"){
-				current_line.push_back("Yes");
-			}
-			else{
-				current_line.push_back("No");
-			};
-		}
-		else{
-		current_line.push_back(string_replace(all_data[i][j],' ', '_'));
-		};
-	};
-  };
-  //Add to organized_data and clear current line
-  current_line.push_back(outcome);
-  organized_data.push_back(current_line);
-  current_line.clear();
-  };
-};
-
-}
-
-int main(int argc, char* argv[]){
-	if(argc!=3){
-		std::cerr << "Only arguments should be a file for reading the data and a query file, respectively.";
-		exit(1);
-	};
-	//Read files
-	std::ifstream inFile(argv[1]);
-	std::ifstream query(argv[2]);
-	std::string team_a;
-	std::string team_b;
-	//Get teams
-	query >> team_a >> team_b;
-	std::vector<std::string> query_features;
-	std::string sub;
-	int years_to_examine = 0;
-	int this_year = 2016;
-	int this_month = 6;
-	int this_day = 8;
-	//Arbitrary date set to somewhere around the time this was written
-	//Simple request for how many years should be examined
-	std::cout << "How many prior years would you like to examine? (please enter an integer value)" << std::endl;
-	std::cin >> years_to_examine; 
-	while(query >> sub){
-		//Get the features of the query
-		query_features.push_back(sub);
-	};
-	if(std::find(query_features.begin(),query_features.end(),"FALSE")!=query_features.end()){
-	/*If the query match is not at a neutral venue, then add "Home" condition using team_a,
-	 * the home team, as a reference.*/
-	query_features.insert(query_features.begin(),"Home");
-	};
-	//Use simple Date class to make minimum date
-	Date starting_date(this_day, this_month, this_year-years_to_examine);
-	std::vector<std::string> base_conditions;
-	std::vector<std::vector<std::string> > all_data;
-	//Format the data
-	format_data(team_a,team_b, inFile, base_conditions, all_data, starting_date);
-	all_data.erase(all_data.begin());
-	//always an odd empty read for std::getline; just remove that element
-	std::vector<std::vector<std::string> > organized_data;
-	//Organize the data
-	organize_data(organized_data,all_data,team_a,team_b);
-	/*Some cleanup for the conditions to have the conditions we want, as some of 
-	 * the conditions specified in the data file are not all that meaningful for
-	 * our purposes (such as venue city)*/
-	std::vector<std::string> final_conditions = base_conditions;
-	final_conditions.erase(final_conditions.begin());
-	final_conditions.erase(final_conditions.begin());
-	final_conditions.erase(final_conditions.begin());
-	final_conditions.erase(final_conditions.begin());
-	final_conditions.insert(final_conditions.begin(),"Home/Away");
-	final_conditions.erase(final_conditions.begin()+1);
-	final_conditions.erase(final_conditions.begin()+2);
-	final_conditions.erase(final_conditions.begin()+2);
-	final_conditions.erase(final_conditions.begin()+2);
-	//final_conditions.insert(final_conditions.begin()+1,"Margin of Victory/Defeat");
-	final_conditions.push_back("Tournament Competition?");
-	final_conditions.push_back("Neutral_Location");
-	final_conditions.push_back("Outcome");
-	//Optional printing of organized data table (uncomment to print)
-	/*
-	for(int i = 0;i<final_conditions.size();i++){
-		std::cout << final_conditions[i] << ' ';
-	};
-	std::cout << std::endl;
-	for(int i=0;i<organized_data.size();i++){
-	 for(int j=0;j<organized_data[i].size();j++){
-		 std::cout << organized_data[i][j] << ' ';	
-	 };
-	 std::cout << std::endl;
-	};*/
-	//Initialize the decision tree
-	DecisionTree<std::string> dt(final_conditions,organized_data,1,3,.3);
-	//Optionally print all paths (uncomment to print)
-	//dt.print_all_paths(std::cout);
-	std::cout << std::endl << "Results with respect to " <<team_a << " vs. " << team_b
-	<< "\n  *Note that the outcome is listed for the home team listed in the query." << std::endl;
-	std::cout << std::endl;
-	/*Print the most certain outcomes for the query.*/
-	dt.print_best_paths_for_query(query_features);
-	return 0;
-}
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <thread>
+#include "tree.h"
+#include "date.h"
+#include "match_table.h"
+/* This program asserts the probable outcome of a certain football match using a decision tree.
+ * Using a data table and a query passed in via the command line, all historical precedents of the
+ * conditions associated with that match are used to form a decision tree and produce an outcome.*/
+
+std::string string_replace(const std::string& a, char replace, char new_char){
+/* This is a utility function to remove spaces for entries in the table*/
+std::string ret="";
+for(int i=0;i<a.size();i++){
+	if(a[i] == replace){
+		ret+= new_char;
+	}
+	else{
+		ret+=a[i];
+	};
+};
+return ret;
+}
+
+
+void format_data(const std::string team_a, const std::string team_b,
+		const MatchTable& matches,
+		std::vector<std::string>& conditions, std::vector<std::vector<std::string> >& data,
+		const Date& starting_year){
+	/*This function formats the data in the data file to produce a data table of strings that can
+	 * later be used to identify appropriate matchups and conditions for the query match. The way this 
+	 * function specifically stores the data is based on an expected structure of the data file. The
+	 * matches between the two teams (in either order) are looked up in the postings of the pair, which
+	 * are in the order of their dates, so the matches from the starting date on are all the postings
+	 * from the first one on that date.*/
+	const std::vector<std::string>& header = matches.get_header();
+	for(int i=0;i+1<header.size();i++){
+	/*The first line holds the generic conditions that describes the data; store those first.*/
+		conditions.push_back(header[i]);
+	};
+	const std::vector<int>& rows = matches.pair_rows(matches.team(team_a),matches.team(team_b));
+	for(int i=matches.first_posting_from(rows,starting_year);i<rows.size();i++){
+		data.push_back(matches.row(rows[i]));
+	};
+}
+
+void organize_data(std::vector<std::vector<std::string> >& organized_data,
+		const std::vector<std::vector<std::string> >& all_data,
+		const std::string& team_a, const std::string& team_b){
+	/* This function organizes the data into the conditions we want to examine. Specifically for
+	 * football matches pertaining to the given data set, there are a certain set of conditions and 
+	 * an outcome we want to identify. These conditions are the following:
+	 * Home/Away, Tournament Competition?, Neutral Venue
+	 * The outcome we search for is simply Win, Loss, or Draw. Note that this is few conditions, but
+	 * the data file doesn't offer much in the way of specific conditions.*/
+std::vector<std::string> current_line;
+for(int i = 0;i<all_data.size();i++){
+  /*If the match pertains to the two teams we are looking for, store the data.*/
+  if((all_data[i][1]==team_a && all_data[i][2] == team_b)||
+     (all_data[i][1] == team_b && all_data[i][2] == team_a)){
+  std::string outcome;
+  bool a_is_home_team;
+  for(int j=0;j<all_data[i].size();j++){
+	if(j==1){
+		/*The first entry pertains to the home team, where we use team_a, the 
+		 * home team in our query, as our reference.*/ 
+		if(all_data[i][j]==team_a){
+			current_line.push_back("Home");
+			a_is_home_team = true;
+		}
+		else{
+			current_line.push_back("Away");
+			a_is_home_team = false;
+		};
+		j++;
+	}
+	else if(j==3){
+		//Assert scores to determine outcome
+		std::stringstream score_home;
+		std::stringstream score_away;
+		score_home << all_data[i][j];
+		score_away << all_data[i][j+1];
+		//String to int conversion
+		int scoreH;
+		int scoreA;
+		score_home >> scoreH;
+		score_away >> scoreA;
+		std::string margin;
+		if(scoreH > scoreA){
+			/*If team_a is the home team in this instance, then a win
+			 * and vice versa.*/
+			if(a_is_home_team){
+			outcome = "Win";
+			}
+			else{
+			outcome = "Loss";
+			};
+		}
+		else if(scoreH < scoreA){
+			/*If team_a is the home team in this instance, then a loss
+			 * and vice versa.*/
+			if(a_is_home_team){
+			outcome = "Loss";
+			}
+			else{
+			outcome = "Win";
+			};
+		}
+		else{
+			//If the scores are even, then outcome is a draw
+			outcome = "Draw";
+		};
+		j++;
+	}
+	else if(j==5 || j==all_data[i].size()-1){
+		if(j==5){
+			/* The fifth entry pertains to the competition. As teams perform
+			 * different in friendlies than in tournaments, assert whether or not
+			 * game is a friendly (an exhibition) or an official match.*/
+			if(all_data[i][j]!="Friendly"){
+				current_line.push_back("Yes");
+			}
+			else{
+				current_line.push_back("No");
+			};
+		}
+		else{
+		current_line.push_back(string_replace(all_data[i][j],' ', '_'));
+		};
+	};
+  };
+  //Add to organized_data and clear current line
+  current_line.push_back(outcome);
+  organized_data.push_back(current_line);
+  current_line.clear();
+  };
+};
+
+}
+
+void read_stream_header(std::istream& in, std::vector<std::string>& conditions, int& width){
+	/*This function reads the first line of a data file that is streamed in and stores its conditions
+	 * just as "format_data" does, along with the number of fields every line has.*/
+	std::string line;
+	while(line.empty() && std::getline(in,line)){
+		if(!line.empty() && line.back()=='\r'){
+			line.pop_back();
+		};
+	};
+	std::vector<std::string_view> names;
+	CsvReader(line).next_row(names);
+	width = names.size();
+	for(int i=0;i+1<names.size();i++){
+		conditions.push_back(std::string(names[i]));
+	};
+}
+
+void stream_data(std::istream& in, int width, const MatchFilter& filter,
+		const std::vector<std::pair<std::string,std::string> >& pairs,
+		std::vector<StreamingTable<std::string> >& tables){
+	/*This function reads the matches of a data file that is streamed in one line at a time. The matches
+	 * the filter keeps are organized for every pair of teams as soon as they are read and counted into the
+	 * table of that pair, so only the distinct organized matches are ever kept, however long the stream is.*/
+	std::string line;
+	std::vector<std::string_view> fields;
+	std::vector<std::vector<std::string> > match(1,std::vector<std::string>(width));
+	std::vector<std::vector<std::string> > organized;
+	while(std::getline(in,line)){
+		CsvReader reader(line);
+		if(!reader.next_row(fields) || fields.size()!=width || !filter.keeps_fields(fields)){
+			continue;
+		};
+		for(int i=0;i<width;i++){
+			match[0][i] = normalize_field(fields[i]);
+		};
+		for(int k=0;k<pairs.size();k++){
+			organize_data(organized,match,pairs[k].first,pairs[k].second);
+			for(int i=0;i<organized.size();i++){
+				tables[k].add_row(organized[i]);
+			};
+			organized.clear();
+		};
+	};
+}
+
+struct Matchup{
+	//One line of the query file: the two teams and the features of the match
+	std::string team_a;
+	std::string team_b;
+	std::vector<std::string> features;
+};
+
+std::vector<Matchup> read_matchups(std::istream& query){
+	/*Every line of the query file that names two teams is a matchup, so a whole fixture list can be
+	 * answered in one run. As before, a match that is not at a neutral venue gets the "Home" feature,
+	 * with team_a, the home team, as a reference.*/
+	std::vector<Matchup> matchups;
+	std::string line;
+	while(std::getline(query,line)){
+		std::istringstream words(line);
+		Matchup matchup;
+		if(!(words >> matchup.team_a >> matchup.team_b)){
+			continue;
+		};
+		std::string sub;
+		while(words >> sub){
+			//Get the features of the query
+			matchup.features.push_back(sub);
+		};
+		if(std::find(matchup.features.begin(),matchup.features.end(),"FALSE")!=matchup.features.end()){
+			matchup.features.insert(matchup.features.begin(),"Home");
+		};
+		matchups.push_back(matchup);
+	};
+	return matchups;
+}
+
+int main(int argc, char* argv[]){
+	if(argc!=3){
+		std::cerr << "Only arguments should be a file for reading the data and a query file, respectively.";
+		exit(1);
+	};
+	/*With "-" as the data file, the matches are streamed in from standard input after the number of
+	 * years, so a feed of any length can be piped in (see "stream_data").*/
+	bool streaming = std::string(argv[1])=="-";
+	//Read files
+	std::ifstream query(argv[2]);
+	//Get teams and features of every matchup
+	std::vector<Matchup> matchups = read_matchups(query);
+	if(matchups.empty()){
+		std::cerr << "The query file should name two teams followed by the features of the match.";
+		exit(1);
+	};
+	int years_to_examine = 0;
+	int this_year = 2016;
+	int this_month = 6;
+	int this_day = 8;
+	//Arbitrary date set to somewhere around the time this was written
+	//Simple request for how many years should be examined
+	std::cout << "How many prior years would you like to examine? (please enter an integer value)" << std::endl;
+	std::cin >> years_to_examine; 
+	//Use simple Date class to make minimum date
+	Date starting_date(this_day, this_month, this_year-years_to_examine);
+	/*The matchups of the same two teams (in the same order) share a table, so every pair gets one forest
+	 * that answers all of its matchups at once.*/
+	std::vector<std::pair<std::string,std::string> > pairs;
+	std::vector<int> pair_of(matchups.size());
+	for(int i=0;i<matchups.size();i++){
+		std::pair<std::string,std::string> teams(matchups[i].team_a,matchups[i].team_b);
+		pair_of[i] = std::find(pairs.begin(),pairs.end(),teams)-pairs.begin();
+		if(pair_of[i]==pairs.size()){
+			pairs.push_back(teams);
+		};
+	};
+	/*Only the matches between the teams since the starting date are loaded, and only with the
+	 * columns that are organized below (the cities and countries are never read).*/
+	MatchFilter filter;
+	filter.from = starting_date;
+	for(int k=0;k<pairs.size();k++){
+		filter.teams.push_back(pairs[k].first);
+		filter.teams.push_back(pairs[k].second);
+	};
+	filter.columns.push_back(MatchTable::HOME_TEAM);
+	filter.columns.push_back(MatchTable::AWAY_TEAM);
+	filter.columns.push_back(MatchTable::TOURNAMENT);
+	filter.columns.push_back(MatchTable::NEUTRAL);
+	std::vector<std::string> base_conditions;
+	std::vector<std::vector<std::vector<std::string> > > organized_data(pairs.size());
+	int stream_width = 0;
+	if(streaming){
+		read_stream_header(std::cin,base_conditions,stream_width);
+	}
+	else{
+		MatchTable matches = MatchTable::open(argv[1],std::thread::hardware_concurrency(),filter);
+		for(int k=0;k<pairs.size();k++){
+			std::vector<std::vector<std::string> > all_data;
+			//Format the data (every pair has the same conditions)
+			base_conditions.clear();
+			format_data(pairs[k].first,pairs[k].second, matches, base_conditions, all_data, starting_date);
+			//Organize the data
+			organize_data(organized_data[k],all_data,pairs[k].first,pairs[k].second);
+		};
+	};
+	/*Some cleanup for the conditions to have the conditions we want, as some of 
+	 * the conditions specified in the data file are not all that meaningful for
+	 * our purposes (such as venue city)*/
+	std::vector<std::string> final_conditions = base_conditions;
+	final_conditions.erase(final_conditions.begin());
+	final_conditions.erase(final_conditions.begin());
+	final_conditions.erase(final_conditions.begin());
+	final_conditions.erase(final_conditions.begin());
+	final_conditions.insert(final_conditions.begin(),"Home/Away");
+	final_conditions.erase(final_conditions.begin()+1);
+	final_conditions.erase(final_conditions.begin()+2);
+	final_conditions.erase(final_conditions.begin()+2);
+	final_conditions.erase(final_conditions.begin()+2);
+	//final_conditions.insert(final_conditions.begin()+1,"Margin of Victory/Defeat");
+	final_conditions.push_back("Tournament Competition?");
+	//The column of Tournament Competition?, whose tree answers the queries no root supports
+	const int tournament_condition = final_conditions.size()-1;
+	final_conditions.push_back("Neutral_Location");
+	final_conditions.push_back("Outcome");
+	//Optional printing of organized data table (uncomment to print)
+	/*
+	for(int i = 0;i<final_conditions.size();i++){
+		std::cout << final_conditions[i] << ' ';
+	};
+	std::cout << std::endl;
+	for(int i=0;i<organized_data[0].size();i++){
+	 for(int j=0;j<organized_data[0][i].size();j++){
+		 std::cout << organized_data[0][i][j] << ' ';	
+	 };
+	 std::cout << std::endl;
+	};*/
+	/*Initialize the decision trees of every root condition at once. The queries are answered by the first
+	 * root with a path that clears "min_occurences", in the order of the conditions: Home/Away, then
+	 * Tournament Competition? and then Neutral_Location. As only a few queries are made, the trees are
+	 * built lazily, and only the paths the queries follow are ever built. With three conditions of two
+	 * features and three outcomes, the whole table fits in a contingency cube of 24 cells, so every count
+	 * is taken from the cube rather than from the matches.*/
+	TreeOptions options;
+	options.lazy = true;
+	options.counting = CONTINGENCY_CUBE;
+	/*Every match is one of a couple dozen combinations of the conditions and the outcome, so the
+	 * identical matches are collapsed into weighted rows before the trees are built.*/
+	std::vector<StreamingTable<std::string> > match_tables(pairs.size(),StreamingTable<std::string>(final_conditions));
+	for(int k=0;k<pairs.size();k++){
+		for(int i=0;i<organized_data[k].size();i++){
+			match_tables[k].add_row(organized_data[k][i]);
+		};
+	};
+	if(streaming){
+		stream_data(std::cin,stream_width,filter,pairs,match_tables);
+	};
+	std::vector<QueryResult<std::string> > results(matchups.size());
+	for(int k=0;k<pairs.size();k++){
+		DecisionForest<std::string> forest(match_tables[k].table(),3,.3,std::vector<int>(),options);
+		//Optionally print all paths of the tree that answers (uncomment to print)
+		//forest.tree(forest.select_tree(matchups[0].features,FIRST_SUPPORTED)).print_all_paths(std::cout);
+		std::vector<int> of_pair;
+		std::vector<std::vector<std::string> > queries;
+		for(int i=0;i<matchups.size();i++){
+			if(pair_of[i]==k){
+				of_pair.push_back(i);
+				queries.push_back(matchups[i].features);
+			};
+		};
+		std::vector<QueryResult<std::string> > answers = forest.query_all(queries,FIRST_SUPPORTED);
+		for(int i=0;i<of_pair.size();i++){
+			results[of_pair[i]] = answers[i];
+			if(!answers[i].supported()){
+				/*No root has a path that clears "min_occurences", so the query gets what the tree of
+				 * Tournament Competition? alone finds (most often its root, with a certainty of 0), as
+				 * it did when that was the only tree.*/
+				results[of_pair[i]] = forest.tree_for_root(tournament_condition).query(queries[i]);
+			};
+		};
+	};
+	/*Print the most certain outcomes for every query, in the order of the query file.*/
+	bool all_matched = true;
+	for(int i=0;i<matchups.size();i++){
+		std::cout << std::endl << "Results with respect to " << matchups[i].team_a << " vs. " << matchups[i].team_b
+		<< "\n  *Note that the outcome is listed for the home team listed in the query." << std::endl;
+		std::cout << std::endl;
+		if(!results[i].matched){
+			std::cerr << "No outcomes matched the conditions in the input query." << std::endl;
+			all_matched = false;
+			continue;
+		};
+		print_query_result(results[i]);
+	};
+	return all_matched ? 0 : 1;
+}
@@ -1,26 +1,51 @@
-#include <string>
-#include <iostream>
-std::string months[12] = {"January", "February", "March", "April", "May", 
-			  "June", "July", "August", "September", "October",
-			  "November", "December"};
-class Date{
-	private:
-	int year;
-	int month;
-	int day;
-	public:
-	Date(int d,int m, int y){day = d;month =m;year=y;}
-	bool operator < (const Date& d){
-		return (year < d.year) || (year ==d.year && month < d.month)||
-			(year==d.year && month==d.month && day < d.day);
-	};
-	int get_year()const{return year;}
-	int get_month()const{return month;}
-	int get_day()const{return day;}
-	friend std::ostream& operator << (std::ostream& ostr, const Date& d);
-
-};
-std::ostream& operator << (std::ostream& ostr, const Date& d){
-	ostr << d.year << '-' << d.month << '-' << d.day;
-	return ostr;
-};
+#ifndef DATE_H
+#define DATE_H
+#include <string>
+#include <string_view>
+#include <iostream>
+std::string months[12] = {"January", "February", "March", "April", "May",
+			  "June", "July", "August", "September", "October",
+			  "November", "December"};
+constexpr int pack_date(int y, int m, int d){
+	//A date as the single integer yyyymmdd, which orders dates the same as comparing year, month and day
+	return y*10000+m*100+d;
+}
+class Date{
+	private:
+	int packed;
+	//The date as yyyymmdd (see "pack_date")
+	public:
+	constexpr Date(int d,int m, int y):packed(pack_date(y,m,d)){}
+	constexpr explicit Date(int yyyymmdd):packed(yyyymmdd){}
+	constexpr bool operator < (const Date& d)const{
+		return packed < d.packed;
+	};
+	constexpr int get_year()const{return packed/10000;}
+	constexpr int get_month()const{return packed/100%100;}
+	constexpr int get_day()const{return packed%100;}
+	constexpr int get_packed()const{return packed;}
+	static Date parse(std::string_view date_string);
+	//Reads a date written as year-month-day (as in the data files)
+	friend std::ostream& operator << (std::ostream& ostr, const Date& d);
+
+};
+inline Date Date::parse(std::string_view date_string){
+	/*The digits of each part are added up as they are read, so no part of the date is ever copied
+	 * into a string of its own.*/
+	int parts[3] = {0,0,0};
+	int part = 0;
+	for(int i=0;i<date_string.size() && part<3;i++){
+		if(date_string[i]=='-'){
+			part++;
+		}
+		else if(date_string[i]>='0' && date_string[i]<='9'){
+			parts[part] = parts[part]*10+(date_string[i]-'0');
+		};
+	};
+	return Date(parts[2],parts[1],parts[0]);
+}
+std::ostream& operator << (std::ostream& ostr, const Date& d){
+	ostr << d.get_year() << '-' << d.get_month() << '-' << d.get_day();
+	return ostr;
+};
+#endif
@@ -0,0 +1,160 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+/*This header file is comprised by a small work-stealing thread pool. Every worker owns a queue
+ * of tasks: a worker takes the newest task from its own queue first (so a depth-first build stays
+ * depth-first on each thread) and, once its queue is empty, steals the oldest task from another
+ * worker's queue, which tends to be the largest piece of work left. Tasks may submit more tasks,
+ * and those go to the queue of the worker that submitted them.*/
+class WorkStealingPool{
+	private:
+	struct TaskQueue{
+		std::mutex lock;
+		std::deque<std::function<void()> > tasks;
+	};
+	struct WorkerTag{
+		const WorkStealingPool* pool;
+		//The pool the thread is a worker of (NULL for any other thread)
+		int id;
+		//The index of the worker in that pool
+	};
+	//MEMBER VARIABLES
+	std::vector<std::unique_ptr<TaskQueue> > queues;
+	//The queue of every worker
+	std::vector<std::thread> workers;
+	//The worker threads
+	std::atomic<int> queued;
+	//The number of tasks waiting in the queues
+	std::atomic<int> pending;
+	//The number of tasks submitted but not yet finished
+	std::atomic<unsigned> next_queue;
+	//The queue that the next task submitted from outside the pool goes to
+	bool stopping;
+	std::mutex state_lock;
+	std::condition_variable work_available;
+	//Signalled when a task is queued or the pool stops
+	std::condition_variable all_done;
+	//Signalled when the last pending task finishes
+
+	//UTILITIES
+	bool run_one(int id);
+	//Runs one task from the worker's own queue or stolen from another (false if there was none)
+	void worker_loop(int id);
+	static WorkerTag& worker_tag(){static thread_local WorkerTag tag = {NULL,-1}; return tag;}
+	//Which worker of which pool the running thread is (a pool's tasks may themselves build on other pools)
+
+	public:
+	//CONSTRUCTORS
+	WorkStealingPool(int num_workers);
+	//ACCESSORS
+	int size()const{return workers.size();}
+	int current_worker()const{return worker_tag().pool==this ? worker_tag().id : -1;}
+	//The index of the worker running on this thread (-1 outside the pool, even on a worker of another pool)
+	//MODIFIERS
+	void submit(const std::function<void()>& task);
+	//Queues a task, on the calling worker's own queue when called from inside the pool
+	void wait();
+	//Blocks until every submitted task, including tasks submitted by tasks, has finished
+	//DESTRUCTOR
+	~WorkStealingPool();
+};
+
+inline WorkStealingPool::WorkStealingPool(int num_workers):queued(0),pending(0),next_queue(0){
+	stopping = false;
+	if(num_workers<1){
+		num_workers = 1;
+	};
+	for(int i=0;i<num_workers;i++){
+		queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+	};
+	for(int i=0;i<num_workers;i++){
+		workers.push_back(std::thread(&WorkStealingPool::worker_loop,this,i));
+	};
+}
+
+inline void WorkStealingPool::submit(const std::function<void()>& task){
+	int id = current_worker();
+	if(id<0){
+		//tasks from outside the pool are dealt out to the workers in turn
+		id = next_queue++ % queues.size();
+	};
+	pending++;
+	{
+		std::lock_guard<std::mutex> guard(queues[id]->lock);
+		queues[id]->tasks.push_back(task);
+	}
+	queued++;
+	{
+		std::lock_guard<std::mutex> guard(state_lock);
+	}
+	work_available.notify_one();
+}
+
+inline bool WorkStealingPool::run_one(int id){
+	/*The worker's own queue is used as a stack and the other queues are stolen from the front.*/
+	std::function<void()> task;
+	for(int i=0;i<queues.size() && !task;i++){
+		TaskQueue& queue = *queues[(id+i)%queues.size()];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if(queue.tasks.empty()){
+			continue;
+		};
+		if(i==0){
+			task.swap(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		else{
+			task.swap(queue.tasks.front());
+			queue.tasks.pop_front();
+		};
+	};
+	if(!task){
+		return false;
+	};
+	queued--;
+	task();
+	if(--pending==0){
+		std::lock_guard<std::mutex> guard(state_lock);
+		all_done.notify_all();
+	};
+	return true;
+}
+
+inline void WorkStealingPool::worker_loop(int id){
+	worker_tag().pool = this;
+	worker_tag().id = id;
+	while(true){
+		if(run_one(id)){
+			continue;
+		};
+		std::unique_lock<std::mutex> guard(state_lock);
+		work_available.wait(guard,[this](){return stopping || queued>0;});
+		if(stopping && queued==0){
+			return;
+		};
+	};
+}
+
+inline void WorkStealingPool::wait(){
+	std::unique_lock<std::mutex> guard(state_lock);
+	all_done.wait(guard,[this](){return pending==0;});
+}
+
+inline WorkStealingPool::~WorkStealingPool(){
+	{
+		std::lock_guard<std::mutex> guard(state_lock);
+		stopping = true;
+	}
+	work_available.notify_all();
+	for(int i=0;i<workers.size();i++){
+		workers[i].join();
+	};
+}
+#endif
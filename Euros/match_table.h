@@ -0,0 +1,586 @@
+#ifndef MATCH_TABLE_H
+#define MATCH_TABLE_H
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include "table.h"
+#include "date.h"
+#include "csv_reader.h"
+/*This header file is comprised by the table of international matches that the football drivers read
+ * from "results.csv". The file is loaded once into columns: the dates are packed into integers (see
+ * date.h), the scores are integers, and the teams, tournaments, cities, countries and neutral venues
+ * are dictionary-encoded. The matches are kept in the order of their dates, so the matches since any
+ * date are one contiguous range of rows that is found with a binary search, and looking at a different
+ * number of years only costs another search. The rows of every team and of every pair of teams are also
+ * indexed once they are loaded, so a matchup only ever looks at the matches between its two teams.
+ * As parsing the whole file is most of the time it takes to answer a matchup, the loaded columns are
+ * also saved next to the data file in a binary cache, which later runs map into memory and copy straight
+ * into the columns. The cache holds a checksum of the data file, so it is rebuilt whenever the data file
+ * changes. A MatchFilter can limit a table to some of its matches and columns, which are then picked out
+ * while the file (or its cache) is read, so the others are never copied at all.*/
+
+inline uint64_t text_checksum(std::string_view text){
+	/*An FNV-1a style hash taken 8 bytes at a time, which is quick enough to check the data file on
+	 * every run.*/
+	uint64_t hash = 14695981039346656037ULL;
+	size_t i = 0;
+	for(;i+8<=text.size();i+=8){
+		uint64_t word;
+		std::memcpy(&word,text.data()+i,8);
+		hash = (hash^word)*1099511628211ULL;
+	};
+	for(;i<text.size();i++){
+		hash = (hash^(unsigned char)text[i])*1099511628211ULL;
+	};
+	return hash^text.size();
+}
+
+inline bool is_listed(const std::vector<std::string>& list, std::string_view field){
+	//Whether a field of the data file is one of a few stored features
+	for(int i=0;i<list.size();i++){
+		if(field_equals(field,list[i])){
+			return true;
+		};
+	};
+	return false;
+}
+
+class MatchFilter{
+	/*This class picks the matches and the columns of the data file that a MatchTable loads. A match is
+	 * kept when it was played in the range of dates, when its teams are in "teams" (both of them, or
+	 * either of them with "either_team") and when its tournament is in "tournaments", where an empty
+	 * list takes every team or tournament. The dates and scores are always loaded, but of the encoded
+	 * columns only those in "columns" are (every column when it is empty).*/
+	public:
+	//MEMBER VARIABLES
+	Date from;
+	Date until;
+	//The date of the first match that is kept and the first date after the matches that are kept
+	std::vector<std::string> teams;
+	bool either_team;
+	std::vector<std::string> tournaments;
+	//Teams and tournaments as they are stored (with underscores in place of spaces)
+	std::vector<int> columns;
+	//The encoded columns to load (see MatchTable::FeatureColumn)
+
+	//CONSTRUCTORS
+	MatchFilter():from(0),until(99999999),either_team(false){}
+	//ACCESSORS
+	bool everything()const;
+	//Whether every match and column is loaded
+	bool keeps(int date, bool home_listed, bool away_listed, bool tournament_listed)const;
+	//Whether a match is kept, from its packed date and whether its teams and its tournament are listed
+	bool keeps_fields(const std::vector<std::string_view>& fields)const;
+	//Whether a line of the data file is kept, from its fields
+};
+
+inline bool MatchFilter::everything()const{
+	return from.get_packed()<=0 && until.get_packed()>=99999999 && teams.empty() && tournaments.empty()
+		&& columns.empty();
+}
+
+inline bool MatchFilter::keeps(int date, bool home_listed, bool away_listed, bool tournament_listed)const{
+	if(date<from.get_packed() || date>=until.get_packed()){
+		return false;
+	};
+	if(!teams.empty() && !(either_team ? home_listed || away_listed : home_listed && away_listed)){
+		return false;
+	};
+	return tournaments.empty() || tournament_listed;
+}
+
+inline bool MatchFilter::keeps_fields(const std::vector<std::string_view>& fields)const{
+	//the teams and the tournament are only compared when there is a list to compare them to
+	return keeps(Date::parse(fields[0]).get_packed(),
+			!teams.empty() && is_listed(teams,fields[1]),
+			!teams.empty() && is_listed(teams,fields[2]),
+			!tournaments.empty() && is_listed(tournaments,fields[5]));
+}
+
+class MatchTable{
+	/*This class represents the matches. The columns of the data file are, in order, the date, the
+	 * home team, the away team, the home score, the away score, the tournament, the city, the country
+	 * and whether the venue was neutral.*/
+	private:
+	//MEMBER VARIABLES
+	std::vector<std::string> header;
+	//The name of every column of the data file
+	std::vector<int> dates;
+	//The packed date of every match, in ascending order
+	std::vector<int> home_scores;
+	std::vector<int> away_scores;
+	EncodedTable<std::string> features;
+	//The encoded columns that are loaded, in the order of home team, away team, tournament, city, country and neutral
+	std::vector<int> slots;
+	//The column in "features" of every FeatureColumn (-1 if it is not loaded)
+	bool complete;
+	//Whether every match and column of the data file is loaded (only such a table is cached)
+	SymbolTable<std::string> teams;
+	//Every team, whether it played at home or away
+	std::vector<int> home_teams;
+	std::vector<int> away_teams;
+	//The team of every code of the home and away columns
+	std::vector<std::vector<int> > team_postings;
+	//The rows of the matches of every team, in ascending order (and so in the order of their dates)
+	std::unordered_map<uint64_t,std::vector<int> > pair_postings;
+	//The rows of the matches between every pair of teams (see "pair_key"), in ascending order
+	static const uint32_t CACHE_MAGIC = 0x4843544d;
+	static const uint32_t CACHE_VERSION = 1;
+	//The first words of every cache file (the magic spells "MTCH")
+
+	//UTILITIES
+	bool read_cache(std::string_view cache, uint64_t checksum, const MatchFilter& filter);
+	//Loads the matches and columns of a filter from a cache of the data file with the given checksum (false if it is not one)
+	std::vector<int> set_columns(std::vector<int> columns);
+	//Sets the slots of some FeatureColumns (every column when there are none), returning them in order
+	void build_index();
+	//Makes the postings of every team and pair of teams from the encoded columns
+	static uint64_t pair_key(int team_a, int team_b);
+	//The same key for both orders of two teams
+
+	public:
+	enum FeatureColumn{HOME_TEAM, AWAY_TEAM, TOURNAMENT, CITY, COUNTRY, NEUTRAL};
+	//CONSTRUCTORS
+	MatchTable(){complete=false;slots.assign(NEUTRAL+1,-1);}
+	MatchTable(const MappedFile& file, int threads=1, const MatchFilter& filter=MatchFilter());
+	static MatchTable open(const std::string& path, int threads=1, const MatchFilter& filter=MatchFilter());
+	//Loads a data file from its cache ("path" followed by ".cache"), making the cache first if it is out of date
+	//ACCESSORS
+	int rows()const{return dates.size();}
+	const std::vector<std::string>& get_header()const{return header;}
+	Date date(int row)const{return Date(dates[row]);}
+	int home_score(int row)const{return home_scores[row];}
+	int away_score(int row)const{return away_scores[row];}
+	bool loaded(FeatureColumn column)const{return slots[column]>=0;}
+	int code(int row, FeatureColumn column)const{return loaded(column) ? features.at(row,slots[column]) : -1;}
+	int lookup(FeatureColumn column, const std::string& feature)const;
+	//The code of a feature in a column (-1 if it does not occur or the column is not loaded)
+	const std::string& decode(FeatureColumn column, int code)const;
+	//The feature of a code (empty for the code -1 of a column that is not loaded)
+	int first_row_from(const Date& d)const;
+	//The first match on or after a date (the number of rows if there is none)
+	int team(const std::string& name)const{return teams.lookup(name);}
+	//The index of a team in the postings (-1 if it never played)
+	const std::vector<int>& team_rows(int team)const;
+	const std::vector<int>& pair_rows(int team_a, int team_b)const;
+	//The rows of the matches of a team, or between two teams in either order (empty for unknown teams)
+	int first_posting_from(const std::vector<int>& postings, const Date& d)const;
+	//The first position in some postings of a match on or after a date (the size of the postings if there is none)
+	std::vector<std::string> row(int r)const;
+	//A match as the fields of its line in the data file (with underscores in place of spaces, and empty fields for the columns that are not loaded)
+	bool save_cache(const std::string& path, uint64_t checksum)const;
+	//Writes the columns to a cache file for a data file with the given checksum
+};
+
+inline std::vector<int> MatchTable::set_columns(std::vector<int> columns){
+	if(columns.empty()){
+		for(int c=HOME_TEAM;c<=NEUTRAL;c++){
+			columns.push_back(c);
+		};
+	};
+	std::sort(columns.begin(),columns.end());
+	columns.erase(std::unique(columns.begin(),columns.end()),columns.end());
+	slots.assign(NEUTRAL+1,-1);
+	for(int i=0;i<columns.size();i++){
+		slots[columns[i]] = i;
+	};
+	return columns;
+}
+
+inline MatchTable::MatchTable(const MappedFile& file, int threads, const MatchFilter& filter){
+	/*The file is read into an encoded table of strings first, with the dates, the scores and the
+	 * columns of the filter of the matches that it keeps. Every distinct date and score is then
+	 * parsed only once through its code, and the rows are put into the order of their dates (matches
+	 * on the same day keep the order of the file). A file without the nine columns of the data file
+	 * leaves the table empty, with none of its columns loaded.*/
+	complete = filter.everything();
+	slots.assign(NEUTRAL+1,-1);
+	std::string_view first_line;
+	std::vector<std::string_view> names;
+	if(CsvReader(file.contents()).next_line(first_line)){
+		CsvReader(first_line).next_row(names);
+	};
+	for(int i=0;i<names.size();i++){
+		header.push_back(std::string(names[i]));
+	};
+	if(header.size()<9){
+		return;
+	};
+	std::vector<int> loaded_columns = set_columns(filter.columns);
+	std::vector<int> file_columns;
+	file_columns.push_back(0);
+	file_columns.push_back(3);
+	file_columns.push_back(4);
+	for(int i=0;i<loaded_columns.size();i++){
+		//the home and away teams come before the scores in the data file
+		file_columns.push_back(loaded_columns[i]<=AWAY_TEAM ? loaded_columns[i]+1 : loaded_columns[i]+3);
+	};
+	bool everything = complete;
+	EncodedTable<std::string> raw = read_csv(file,threads,[&filter,everything](const std::vector<std::string_view>& fields){
+		return everything || filter.keeps_fields(fields);
+	},file_columns);
+	std::vector<int> date_of_code(raw.symbols(0).size());
+	for(int code=0;code<date_of_code.size();code++){
+		date_of_code[code] = Date::parse(raw.decode(0,code)).get_packed();
+	};
+	std::vector<int> score_of_code[2];
+	for(int k=0;k<2;k++){
+		for(int code=0;code<raw.symbols(1+k).size();code++){
+			score_of_code[k].push_back(parse_int(raw.decode(1+k,code)));
+		};
+	};
+	std::vector<int> order(raw.rows());
+	for(int r=0;r<order.size();r++){
+		order[r] = r;
+	};
+	const std::vector<int>& date_column = raw.column(0);
+	std::stable_sort(order.begin(),order.end(),[&date_of_code,&date_column](int a, int b){
+		return date_of_code[date_column[a]] < date_of_code[date_column[b]];
+	});
+	for(int i=0;i<order.size();i++){
+		dates.push_back(date_of_code[raw.at(order[i],0)]);
+		home_scores.push_back(score_of_code[0][raw.at(order[i],1)]);
+		away_scores.push_back(score_of_code[1][raw.at(order[i],2)]);
+	};
+	std::vector<int> feature_columns;
+	for(int c=3;c<raw.width();c++){
+		feature_columns.push_back(c);
+	};
+	features = raw.select(feature_columns,order);
+	build_index();
+}
+
+inline int MatchTable::lookup(FeatureColumn column, const std::string& feature)const{
+	if(!loaded(column)){
+		return -1;
+	};
+	return features.symbols(slots[column]).lookup(feature);
+}
+
+inline const std::string& MatchTable::decode(FeatureColumn column, int code)const{
+	static const std::string none;
+	if(code<0){
+		return none;
+	};
+	return features.decode(slots[column],code);
+}
+
+inline uint64_t MatchTable::pair_key(int team_a, int team_b){
+	if(team_b<team_a){
+		std::swap(team_a,team_b);
+	};
+	return ((uint64_t)team_a<<32)|(uint32_t)team_b;
+}
+
+inline void MatchTable::build_index(){
+	/*The home and away columns have symbol tables of their own, so both are first mapped onto one
+	 * table of teams. The postings are then made in a single pass over the rows, which keeps the rows
+	 * of every posting in ascending order.*/
+	teams = SymbolTable<std::string>();
+	home_teams.clear();
+	away_teams.clear();
+	team_postings.clear();
+	pair_postings.clear();
+	if(!loaded(HOME_TEAM) || !loaded(AWAY_TEAM)){
+		return;
+	};
+	for(int code=0;code<features.symbols(slots[HOME_TEAM]).size();code++){
+		home_teams.push_back(teams.encode(decode(HOME_TEAM,code)));
+	};
+	for(int code=0;code<features.symbols(slots[AWAY_TEAM]).size();code++){
+		away_teams.push_back(teams.encode(decode(AWAY_TEAM,code)));
+	};
+	team_postings.resize(teams.size());
+	const std::vector<int>& home_column = features.column(slots[HOME_TEAM]);
+	const std::vector<int>& away_column = features.column(slots[AWAY_TEAM]);
+	for(int r=0;r<rows();r++){
+		int home = home_teams[home_column[r]];
+		int away = away_teams[away_column[r]];
+		team_postings[home].push_back(r);
+		if(away!=home){
+			team_postings[away].push_back(r);
+		};
+		pair_postings[pair_key(home,away)].push_back(r);
+	};
+}
+
+inline const std::vector<int>& MatchTable::team_rows(int team)const{
+	static const std::vector<int> none;
+	if(team<0 || team>=team_postings.size()){
+		return none;
+	};
+	return team_postings[team];
+}
+
+inline const std::vector<int>& MatchTable::pair_rows(int team_a, int team_b)const{
+	static const std::vector<int> none;
+	if(team_a<0 || team_b<0){
+		return none;
+	};
+	std::unordered_map<uint64_t,std::vector<int> >::const_iterator itr = pair_postings.find(pair_key(team_a,team_b));
+	if(itr==pair_postings.end()){
+		return none;
+	};
+	return itr->second;
+}
+
+inline int MatchTable::first_posting_from(const std::vector<int>& postings, const Date& d)const{
+	//the rows of the postings ascend, and so do their dates
+	const std::vector<int>& match_dates = dates;
+	int packed = d.get_packed();
+	return std::lower_bound(postings.begin(),postings.end(),packed,[&match_dates](int row, int date){
+		return match_dates[row] < date;
+	})-postings.begin();
+}
+
+inline int MatchTable::first_row_from(const Date& d)const{
+	return std::lower_bound(dates.begin(),dates.end(),d.get_packed())-dates.begin();
+}
+
+inline std::vector<std::string> MatchTable::row(int r)const{
+	std::vector<std::string> ret;
+	Date d = date(r);
+	std::string month = std::to_string(d.get_month());
+	std::string day = std::to_string(d.get_day());
+	ret.push_back(std::to_string(d.get_year())+'-'+std::string(2-std::min<int>(2,month.size()),'0')+month+'-'
+			+std::string(2-std::min<int>(2,day.size()),'0')+day);
+	ret.push_back(decode(HOME_TEAM,code(r,HOME_TEAM)));
+	ret.push_back(decode(AWAY_TEAM,code(r,AWAY_TEAM)));
+	ret.push_back(std::to_string(home_score(r)));
+	ret.push_back(std::to_string(away_score(r)));
+	for(int c=TOURNAMENT;c<=NEUTRAL;c++){
+		ret.push_back(decode((FeatureColumn)c,code(r,(FeatureColumn)c)));
+	};
+	return ret;
+}
+
+/*The cache file is made of 32-bit words and strings (a length followed by its characters), in this order:
+ * the magic and version, the checksum of the data file (two words), the names of the header, the number
+ * of rows, the dates, the home and away scores, and then the symbol table and the codes of every encoded
+ * column.*/
+inline void write_word(std::ofstream& out, uint32_t word){
+	out.write((const char*)&word,sizeof(word));
+}
+
+inline void write_text(std::ofstream& out, const std::string& text){
+	write_word(out,text.size());
+	out.write(text.data(),text.size());
+}
+
+inline void write_words(std::ofstream& out, const std::vector<int>& words){
+	out.write((const char*)words.data(),words.size()*sizeof(int));
+}
+
+inline bool MatchTable::save_cache(const std::string& path, uint64_t checksum)const{
+	/*The cache is written to a file of its own and then renamed, so a run never maps a cache that
+	 * another run is still writing. Only a table of every match and column can stand in for the data file.*/
+	if(!complete){
+		return false;
+	};
+#ifdef CSV_MMAP
+	std::string temporary = path+".tmp"+std::to_string(getpid());
+#else
+	std::string temporary = path+".tmp";
+#endif
+	{
+		std::ofstream out(temporary.c_str(),std::ios::binary);
+		if(!out){
+			return false;
+		};
+		write_word(out,CACHE_MAGIC);
+		write_word(out,CACHE_VERSION);
+		write_word(out,(uint32_t)checksum);
+		write_word(out,(uint32_t)(checksum>>32));
+		write_word(out,header.size());
+		for(int i=0;i<header.size();i++){
+			write_text(out,header[i]);
+		};
+		write_word(out,rows());
+		write_words(out,dates);
+		write_words(out,home_scores);
+		write_words(out,away_scores);
+		write_word(out,features.width());
+		for(int c=0;c<features.width();c++){
+			write_text(out,features.condition(c));
+			write_word(out,features.symbols(c).size());
+			for(int code=0;code<features.symbols(c).size();code++){
+				write_text(out,features.decode(c,code));
+			};
+			write_words(out,features.column(c));
+		};
+		if(!out){
+			std::remove(temporary.c_str());
+			return false;
+		};
+	}
+	return std::rename(temporary.c_str(),path.c_str())==0;
+}
+
+class CacheCursor{
+	/*Reads the words and strings of a cache file in order, failing (rather than reading past the end)
+	 * when the file is cut short.*/
+	private:
+	std::string_view data;
+	size_t position;
+	bool failed;
+	public:
+	CacheCursor(std::string_view d){data=d;position=0;failed=false;}
+	bool ok()const{return !failed;}
+	uint32_t word(){
+		uint32_t ret = 0;
+		if(position+sizeof(ret)>data.size()){
+			failed = true;
+			return 0;
+		};
+		std::memcpy(&ret,data.data()+position,sizeof(ret));
+		position += sizeof(ret);
+		return ret;
+	}
+	std::string_view bytes(size_t count){
+		if(failed || position+count>data.size()){
+			failed = true;
+			return std::string_view();
+		};
+		position += count;
+		return data.substr(position-count,count);
+	}
+	std::string_view text_view(){
+		uint32_t length = word();
+		return bytes(length);
+	}
+	std::string text(){return std::string(text_view());}
+};
+
+inline int word_at(std::string_view words, int i){
+	//The i-th word of some words of a cache file
+	int ret;
+	std::memcpy(&ret,words.data()+(size_t)i*sizeof(int),sizeof(int));
+	return ret;
+}
+
+inline bool MatchTable::read_cache(std::string_view cache, uint64_t checksum, const MatchFilter& filter){
+	/*The columns are only looked at where they are in the mapped cache at first. The symbols of the
+	 * columns that the filter looks at are checked against its lists, after which the kept matches are
+	 * found from their codes and only those are copied out of the loaded columns.*/
+	CacheCursor cursor(cache);
+	if(cursor.word()!=CACHE_MAGIC || cursor.word()!=CACHE_VERSION){
+		return false;
+	};
+	uint64_t low = cursor.word();
+	uint64_t high = cursor.word();
+	if(!cursor.ok() || (low|(high<<32))!=checksum){
+		return false;
+	};
+	header.resize(cursor.word());
+	for(int i=0;i<header.size() && cursor.ok();i++){
+		header[i] = cursor.text();
+	};
+	uint32_t num_rows = cursor.word();
+	std::string_view date_words = cursor.bytes((size_t)num_rows*sizeof(int));
+	std::string_view home_score_words = cursor.bytes((size_t)num_rows*sizeof(int));
+	std::string_view away_score_words = cursor.bytes((size_t)num_rows*sizeof(int));
+	if(cursor.word()!=NEUTRAL+1){
+		return false;
+	};
+	complete = filter.everything();
+	std::vector<int> loaded_columns = set_columns(filter.columns);
+	std::vector<std::string> names;
+	std::vector<SymbolTable<std::string> > tables;
+	std::vector<char> listed[NEUTRAL+1];
+	//Whether every symbol of the team and tournament columns is in the lists of the filter
+	std::string_view code_words[NEUTRAL+1];
+	for(int c=HOME_TEAM;c<=NEUTRAL && cursor.ok();c++){
+		const std::vector<std::string>& list = c==TOURNAMENT ? filter.tournaments : filter.teams;
+		std::string name = cursor.text();
+		uint32_t num_symbols = cursor.word();
+		if(loaded((FeatureColumn)c)){
+			names.push_back(name);
+			tables.push_back(SymbolTable<std::string>());
+		};
+		for(int code=0;code<num_symbols && cursor.ok();code++){
+			std::string_view symbol = cursor.text_view();
+			if(loaded((FeatureColumn)c)){
+				tables.back().encode(std::string(symbol));
+			};
+			if(c<=TOURNAMENT){
+				listed[c].push_back(!list.empty() && std::find(list.begin(),list.end(),symbol)!=list.end());
+			};
+		};
+		if(loaded((FeatureColumn)c) && tables.back().size()!=num_symbols){
+			return false;
+		};
+		code_words[c] = cursor.bytes((size_t)num_rows*sizeof(int));
+	};
+	if(!cursor.ok()){
+		return false;
+	};
+	std::vector<int> kept;
+	for(int r=0;r<num_rows;r++){
+		int home = word_at(code_words[HOME_TEAM],r);
+		int away = word_at(code_words[AWAY_TEAM],r);
+		int tournament = word_at(code_words[TOURNAMENT],r);
+		if(home<0 || home>=listed[HOME_TEAM].size() || away<0 || away>=listed[AWAY_TEAM].size()
+				|| tournament<0 || tournament>=listed[TOURNAMENT].size()){
+			return false;
+		};
+		if(filter.keeps(word_at(date_words,r),listed[HOME_TEAM][home],listed[AWAY_TEAM][away],listed[TOURNAMENT][tournament])){
+			kept.push_back(r);
+		};
+	};
+	std::vector<std::vector<int> > columns(loaded_columns.size(),std::vector<int>(kept.size()));
+	for(int i=0;i<kept.size();i++){
+		dates.push_back(word_at(date_words,kept[i]));
+		home_scores.push_back(word_at(home_score_words,kept[i]));
+		away_scores.push_back(word_at(away_score_words,kept[i]));
+		for(int k=0;k<loaded_columns.size();k++){
+			columns[k][i] = word_at(code_words[loaded_columns[k]],kept[i]);
+			if(columns[k][i]<0 || columns[k][i]>=tables[k].size()){
+				return false;
+			};
+		};
+	};
+	features = EncodedTable<std::string>(names,tables,columns);
+	build_index();
+	return true;
+}
+
+inline MatchTable MatchTable::open(const std::string& path, int threads, const MatchFilter& filter){
+	/*The data file is mapped either way to check it against the cache, which is only read if it was
+	 * made from the same data. Otherwise the whole data file is parsed once to make the cache again and
+	 * the matches of the filter are then read from the new cache. Only when the cache cannot be written
+	 * is the filter applied while the data file itself is parsed (and the next run parses it as well).*/
+	MappedFile file(path);
+	if(!file.is_open()){
+		return MatchTable();
+	};
+	uint64_t checksum = text_checksum(file.contents());
+	std::string cache_path = path+".cache";
+	{
+		MappedFile cache(cache_path);
+		MatchTable cached;
+		if(cache.is_open() && cached.read_cache(cache.contents(),checksum,filter)){
+			return cached;
+		};
+	}
+	bool saved;
+	{
+		MatchTable parsed(file,threads);
+		saved = parsed.save_cache(cache_path,checksum);
+		if(filter.everything()){
+			return parsed;
+		};
+	}
+	if(saved){
+		MappedFile cache(cache_path);
+		MatchTable cached;
+		if(cache.is_open() && cached.read_cache(cache.contents(),checksum,filter)){
+			return cached;
+		};
+	};
+	return MatchTable(file,threads,filter);
+}
+#endif
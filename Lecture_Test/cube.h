@@ -0,0 +1,170 @@
+#ifndef CUBE_H
+#define CUBE_H
+#include <vector>
+#include <map>
+#include "table.h"
+/*This header file is comprised by the contingency cube of an encoded table. The cube holds the number
+ * of rows of every combination of features over all the columns, the outcome included, and it is made in
+ * a single pass over the rows (a weighted row counts as many times as its weight). Every count the tree
+ * needs is then a sum of cells of the cube (the cells that match the features on a path), so once the
+ * cube is made, building a tree never touches the rows again and takes the same time however many rows
+ * the table has. When the columns have few features, the cube is a dense array of every combination;
+ * otherwise it only keeps the combinations that occur.*/
+
+class ContingencyCube{
+	/*This class represents the cube. A dense cube is indexed like a multi-dimensional array, with a
+	 * stride for every column, and a sparse cube is a list of the distinct rows of the table, each with
+	 * the number of times it occurs.*/
+	private:
+	//MEMBER VARIABLES
+	int width;
+	//The number of columns in every cell
+	std::vector<int> sizes;
+	//The number of features of every column
+	bool dense;
+	//Whether every combination of features has a cell
+	std::vector<int> strides;
+	//How far apart the cells of consecutive features of every column are (dense cubes only)
+	std::vector<int> counts;
+	//The count of every cell
+	std::vector<int> cells;
+	//The features of every cell, "width" codes per cell (sparse cubes only)
+
+	//UTILITIES
+	void marginalize_dense(const std::vector<int>& fixed, int condition, int outcome_column,
+			std::vector<int>& outcomes)const;
+	void marginalize_sparse(const std::vector<int>& fixed, int condition, int outcome_column,
+			std::vector<int>& outcomes)const;
+	//Utilities for "marginalize" for either kind of cube
+
+	public:
+	//CONSTRUCTORS
+	template <class T>
+	ContingencyCube(const EncodedTable<T>& table, int max_dense_cells=1<<20);
+	//Makes a dense cube if it has no more than "max_dense_cells" cells and a sparse cube otherwise
+	//ACCESSORS
+	bool is_dense()const{return dense;}
+	int num_cells()const{return counts.size();}
+	//PUBLIC UTILITIES
+	void marginalize(const std::vector<int>& prior_features, const std::vector<int>& feature_indices,
+			int outcome_column, std::vector<int>& outcomes)const;
+	/*Adds up the rows that match the prior features for every feature of the new condition (the last
+	 * of "feature_indices") and every outcome, in the layout of "get_certainties"*/
+};
+
+template <class T>
+ContingencyCube::ContingencyCube(const EncodedTable<T>& table, int max_dense_cells){
+	/*The cube is dense whenever the product of the numbers of features of the columns is small enough.
+	 * A sparse cube groups the rows by all of their codes, so it has one cell per distinct row.*/
+	width = table.width();
+	double num_dense = 1;
+	for(int c=0;c<width;c++){
+		sizes.push_back(table.symbols(c).size());
+		num_dense *= sizes[c];
+	};
+	dense = num_dense <= max_dense_cells;
+	if(dense){
+		strides.assign(width,1);
+		for(int c=width-2;c>=0;c--){
+			strides[c] = strides[c+1]*sizes[c+1];
+		};
+		counts.assign((int)num_dense,0);
+		for(int i=0;i<table.rows();i++){
+			int cell = 0;
+			for(int c=0;c<width;c++){
+				cell += table.at(i,c)*strides[c];
+			};
+			counts[cell] += table.weight(i);
+		};
+		return;
+	};
+	std::map<std::vector<int>,int> cell_of_row;
+	std::vector<int> key(width);
+	for(int i=0;i<table.rows();i++){
+		for(int c=0;c<width;c++){
+			key[c] = table.at(i,c);
+		};
+		std::map<std::vector<int>,int>::iterator itr = cell_of_row.find(key);
+		if(itr!=cell_of_row.end()){
+			counts[itr->second] += table.weight(i);
+			continue;
+		};
+		cell_of_row[key] = counts.size();
+		counts.push_back(table.weight(i));
+		for(int c=0;c<width;c++){
+			cells.push_back(table.at(i,c));
+		};
+	};
+}
+
+inline void ContingencyCube::marginalize(const std::vector<int>& prior_features,
+		const std::vector<int>& feature_indices, int outcome_column, std::vector<int>& outcomes)const{
+	//"fixed" holds the feature every column must have (-1 for the columns that are summed over)
+	std::vector<int> fixed(width,-1);
+	for(int j=0;j<prior_features.size();j++){
+		fixed[feature_indices[j]] = prior_features[j];
+	};
+	if(dense){
+		marginalize_dense(fixed,feature_indices.back(),outcome_column,outcomes);
+	}
+	else{
+		marginalize_sparse(fixed,feature_indices.back(),outcome_column,outcomes);
+	};
+}
+
+inline void ContingencyCube::marginalize_dense(const std::vector<int>& fixed, int condition,
+		int outcome_column, std::vector<int>& outcomes)const{
+	/*Only the cells with the fixed features are visited: the fixed columns give the offset of the
+	 * first of them, and the other columns are walked through like the digits of a counter.*/
+	if(counts.empty()){
+		//a table without rows has a column without features, and so no cells at all
+		return;
+	};
+	int base = 0;
+	std::vector<int> free_columns;
+	for(int c=0;c<width;c++){
+		if(fixed[c]>=0){
+			base += fixed[c]*strides[c];
+		}
+		else{
+			free_columns.push_back(c);
+		};
+	};
+	int num_outcomes = sizes[outcome_column];
+	std::vector<int> digits(width,0);
+	while(true){
+		int cell = base;
+		for(int k=0;k<free_columns.size();k++){
+			cell += digits[free_columns[k]]*strides[free_columns[k]];
+		};
+		if(counts[cell]){
+			outcomes[digits[condition]*num_outcomes+digits[outcome_column]] += counts[cell];
+		};
+		int k = free_columns.size()-1;
+		for(;k>=0;k--){
+			if(++digits[free_columns[k]] < sizes[free_columns[k]]){
+				break;
+			};
+			digits[free_columns[k]] = 0;
+		};
+		if(k<0){
+			return;
+		};
+	};
+}
+
+inline void ContingencyCube::marginalize_sparse(const std::vector<int>& fixed, int condition,
+		int outcome_column, std::vector<int>& outcomes)const{
+	int num_outcomes = sizes[outcome_column];
+	for(int i=0;i<counts.size();i++){
+		const int* cell = &cells[i*width];
+		bool candidate = true;
+		for(int c=0;c<width && candidate;c++){
+			candidate = fixed[c]<0 || cell[c]==fixed[c];
+		};
+		if(candidate){
+			outcomes[cell[condition]*num_outcomes+cell[outcome_column]] += counts[i];
+		};
+	};
+}
+#endif
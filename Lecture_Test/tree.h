@@ -1,468 +1,2061 @@
-#include <string>
-#include <iostream>
-#include <vector>
-#include <set>
-#include <map>
-#include <algorithm>
-#include <iomanip>
-/*This header file is comprised by the DecisionTree class and its utility node
- * class. The decision tree, in general, is a tool to examine possible outcomes 
- * relative to established precedents in order to ultimately, as the name suggests,
- * make a decision. The implementation of the decision tree here is a non-binary tree
- * that propagates with the nodes having children. When a node does not have a child, there
- * are no more possibilities to explore an outcome of some degree of certainty is found. Per
- * a data table that the user provides, the decision tree is constructed, and the user can then
- * examine all outcomes that fit a custom query.*/
-template <class T>
-class DecisionTreeNode{
-	/*This class represents the nodes that make up a decision tree. It stores
-	 * important information regarding potential outcomes and the subsequent nodes
-	 * to which it points, its children. Note that everything is left public as the
-	 * user is not supposed to access this class, and it is only used in constructing
-	 * the decision tree. */
-	public:
-	//CONSTRUCTORS
-	DecisionTreeNode(const T& p, const T& i, std::map<T,float> c)
-			{item = i; parent_condition=p;outcome_certainties =c;}
-	DecisionTreeNode(const T& p){item = p; parent_condition=p;}
-	DecisionTreeNode(const T& p, std::map<T,float> c){item = p; parent_condition=p;outcome_certainties=c;}
-
-	//Member variables
-	std::vector<DecisionTreeNode<T>*> children;
-	//Pointers to subseqent nodes
-	T item;
-	//The feature that describes the condition the node represents
-	T parent_condition;
-	//The condition to which the feature refers
-	DecisionTreeNode<T>* parent;
-	//The parent node
-	std::map<T, float> outcome_certainties;
-	//All possible outcomes at this node from its path and their certainties (% occurence)
-};
-	
-	
-template <class T>
-class DecisionTree{
-	/* This class represents a decision tree. Comprised of a series of DecisionTreeNode's,
-	 * each node in the tree is dynamically allocated memory and properly de-allocated once
-	 * the DecisionTree goes out of scope. In terms of the behavior of the tree, the tree will
-	 * examine all possible combinations of conditions by forming paths in the tree, but once a
-	 * certain degree of certainty is found, the node is "pruned" so as not to overfit the data.
-	 * This degree of certainty can be specified by the user, as well as the minimum number of
-	 * occurences an outcome needs in order to be valid, another safety net to avoid overfitting.
-	 * Ultimately, the DecisionTree class forms all paths that will lead to the certainty the user
-	 * is looking for provided there is a path as such that exists. */ 
-	private:
-	//MEMBER VARIABLES
-	int size_;
-	//To track the size of the tree
-	int min_occurences;
-	//Minimum number of occurences an outcome needs (overfitting avoidance)	
-	float prune_certainty;
-	//Certainty at which pruning occurs (overfitting avoidance)
-	DecisionTreeNode<T>* root;
-	//The root node of the tree (all other nodes can be accessed from the root)
-	
-	//UTILITIES
-	void print_sideways(std::ostream& ostr,DecisionTreeNode<T>* p, int depth)const;	
-	//A recursive utility for the "print_sideways" public option
-
-	void build_decision_tree(const std::vector<T>& conditions,
-	       	const std::vector<std::vector<T> >& data, DecisionTreeNode<T>* p, const std::vector<int>&
-		conditions_found, const std::vector<T>& features_path,int root_condition_index);
-	//A utility for the constructor, this builds the decision tree in a depth-first fashion
-
-	void destroy_tree(DecisionTreeNode<T>* p);
-	//Utility for the destructor to de-allocate the assigned memory
-
-
-	std::map<T,std::map<T, float> > get_certainties(const std::vector<T>& prior_features,
-			const std::vector<int>& feature_indices,
-		       	const std::vector<std::vector<T> >& data);
-	//A recursive utiltiy to "get_certainties"'s public option
-	void print_all_paths(std::ostream& ostr, DecisionTreeNode<T>* p,
-		       	const std::vector<DecisionTreeNode<T>* >& path)const;
-	//A recursive utility "print_all_paths"'s public option 
-
-	void get_best_paths(const std::vector<T>& query, const std::vector<DecisionTreeNode<T>*>&  current_path,
-				std::vector<std::vector<DecisionTreeNode<T>* > >& best_paths,
-				float& best_certainty, DecisionTreeNode<T>* p,std::vector<T>& outcomes)const;
-	//A recursive utility "print_best_paths_for_query"'s public option 
-	bool is_rearranged_path(
-			const std::vector<std::vector<DecisionTreeNode<T>* > >& best_paths,
-					const std::vector<DecisionTreeNode<T>* > path)const;
-	//A private utility to assert whether a path is non-unique (a re-arranged sequence)
-	void print_path_to_parent(DecisionTreeNode<T>* p)const;
-	//A private utility for debugging to print the path to the root node
-
-	public:
-	//CONSTRUCTORS
-	DecisionTree(const std::vector<T>& conditions, const std::vector<std::vector<T> >& data,
-	       	int root_condition_index,int min_occur, float prune);
-	//ACCESSORS
-	int get_size()const{return size_;}
-
-	//PUBLIC UTILITIES
-	void print_best_paths_for_query(const std::vector<T>& query)const;
-	//Prints the paths that generate the highest degree of certainty
-	void print_sideways(std::ostream& ostr)const;
-	//A utility to print the shape of the tree sideways (Note this does not work well with many children)
-	void print_all_paths(std::ostream& ostr)const;
-	//A utility print all the paths in the tree from the root if tree cannot be visualized with "print_sideways"
-	
-	//DESTRUCTOR
-	~DecisionTree(){this->destroy_tree(root);}
-};
-
-template <class T>
-void DecisionTree<T>::print_path_to_parent(DecisionTreeNode<T>* p)const{
-	/*This function simply prints the path to the root from the node passed in.
-	 * It is not publicly available and was used for debugging.*/
-	DecisionTreeNode<T>* temp = p;
-	while(temp->parent){
-	std::cout<< temp->item << ' ';
-	temp=temp->parent;
-	};
-}
-
-
-
-template <class T>
-typename std::map<T,std::map<T,float> >
-DecisionTree<T>::get_certainties(const std::vector<T>& prior_features, const std::vector<int>& feature_indices,
-			const std::vector<std::vector<T> >& data){
-	/*This function asserts the likely outcomes of the features provided. This is done by passing in a vector
-	 * of indices that represent the features also passed in as the templated class, but an extra index in 
-	 * "feature_indices" represents the new outcome that we would like to assert. Essentially, the function
-	 * is characterized by the question: *How many times do the things found out these indices occur as the
-	 *  combination shown in the features? */
-	std::map<T,std::map<T,int> > outcomes;
-	//map outcome conditions to number of results for each outcome for each set of conditions
-	std::string checker = "";
-	/*For every set of features in the data table, we want to see those instances that
-	 * adhere to the features specified. */
-	for(int i = 0;i<data.size();i++){
-		int candidate = true;
-		checker = "";
-		for(int j=0;j<prior_features.size();j++){
-			int index = feature_indices[j];
-			checker +=prior_features[j]+' ';
-			if(data[i][index] != prior_features[j]){
-			/*If an entry for those indices in the data is not in our features,
-			 * then we don't need to examine that line of data.*/
-				candidate = false;
-				break;
-			};
-		};
-		if(candidate){
-			//If it is a candidate, we increment the outcome associated with the set of features
-			int index = feature_indices.back();
-			//take the most recently added index
-			outcomes[data[i][index]][data[i].back()]++;
-		};
-	};
-	typename std::map<T,std::map<T,int> >::iterator outcomes_itr;
-	std::map<T,std::map<T,float> > ret_certainties;
-	for(outcomes_itr = outcomes.begin();outcomes_itr!=outcomes.end();outcomes_itr++){
-		/*Here, we check if the outcomes meet the rquirement specified by "min_occurences"*/
-		typename std::map<T,int>::iterator outcomes_itr2=outcomes_itr->second.begin();
-		int denom = 0;
-		for(;outcomes_itr2!=outcomes_itr->second.end();outcomes_itr2++){
-			denom+= outcomes_itr2->second;
-		};
-		for(outcomes_itr2=outcomes_itr->second.begin();
-		    outcomes_itr2!=outcomes_itr->second.end();outcomes_itr2++){
-			if(denom >=min_occurences){
-			//overfitting restriction => want at least this many occurences
-			ret_certainties[outcomes_itr->first][outcomes_itr2->first] = 
-				(float)outcomes_itr2->second/denom;
-			};
-		};
-	};
-	return ret_certainties;
-	
-}
-
-
-template <class T>
-void DecisionTree<T>::build_decision_tree(const std::vector<T>& conditions,
-	       	const std::vector<std::vector<T> >& data, DecisionTreeNode<T>* p,
-		const std::vector<int>& conditions_found, const std::vector<T>& features_path,
-		int root_condition_index){
-	/* This function is a utility for the constructor and recursively builds the decision tree.*/
-	if(!p){
-		//BASE CASE
-		return;
-	};
-	for(int i=0;i<conditions.size()-1;i++){
-		//for every possible condition (note that last entry, the outcome, is not considered)
-		if(std::find(conditions_found.begin(),conditions_found.end(),i)==conditions_found.end()){
-			if((conditions_found.size()==0&&i==root_condition_index)||conditions_found.size()>0){
-			/*If the condition has not been found, as in it is not on the current path, we can
-			 * create a new node.*/
-			std::vector<int> conditions_found_copy = conditions_found;
-			conditions_found_copy.push_back(i);
-			std::map<T,std::map<T,float> > certainties = get_certainties(features_path,
-					conditions_found_copy,data);
-			typename std::map<T,std::map<T,float> >::iterator itr;
-			for(itr = certainties.begin();itr!=certainties.end();itr++){
-				/*Create a feature for every feature associated with a condition*/
-				DecisionTreeNode<T>* new_node = 
-					new DecisionTreeNode<T>(conditions[i], itr->first,itr->second);
-				size_++;
-				p->children.push_back(new_node);
-				//add new node to current node's children
-				new_node->parent =p;
-				//assign parent
-				bool make_leaf = false;
-				typename std::map<T,float>::iterator prune_checker;
-				for(prune_checker =itr->second.begin();prune_checker!=itr->second.end();
-						prune_checker++){
-					/*If the node has an outcome with a certainty >= "prune_certainty",
-					 * we can make the new node a leaf.*/
-					if(prune_checker->second >= prune_certainty){
-						make_leaf = true;
-						break;
-					};
-					
-				};
-				std::vector<T> features_path_copy = features_path;
-				features_path_copy.push_back(itr->first);
-				//copy the new feature to the features on the path
-				if(!make_leaf){
-				/*If the node is a leaf, then there is no need to continue adding to the path.*/
-				build_decision_tree(conditions,data,new_node, conditions_found_copy,
-						features_path_copy,root_condition_index);
-				//Continue building with the node just created, thereby doing a depth-first build
-				};
-			};
-			};
-		};
-	};
-}	
-
-template<class T>
-DecisionTree<T>::DecisionTree(const std::vector<T>& conditions, const std::vector<std::vector<T> >& data,
-	       	int root_condition_index,int min_occur, float prune){
-	/* The constructor allocated memory for the root, which serves as a dummy. Each decision tree starts 
-	 * at one of the condition specified and builds from there, where the "root condition" technically serves
-	 * as the root of the tree even though it does not technically offer any information about the outcome alone.
-	 * This simply allows us to build from a certain condition to look for optimal trees.*/
-	prune_certainty=prune;
-	min_occurences = min_occur;
-	//dummy_root
-	std::vector<int> conditions_found;
-	std::vector<T> features_path;
-	root = new DecisionTreeNode<T>(conditions[root_condition_index]);
-	//dummy_root node with starting condition
-	size_=1;
-	this->build_decision_tree(conditions, data, root,conditions_found, features_path,root_condition_index);
-
-}
-
-
-template<class T> void DecisionTree<T>::print_sideways(std::ostream& ostr) const {
-    //DRIVER FOR PRINT_SIDEWAYS
-    if(this->size_==0){
-    	ostr << "Tree is empty.\n";
-	return;
-    };
-    print_sideways(ostr, this->root, 0);
-}
-
-template <class T> void DecisionTree<T>::print_all_paths(std::ostream& ostr, DecisionTreeNode<T>* p,
-		const std::vector<DecisionTreeNode<T>*>& path)const{
-/* This recursive function prints all the paths in the tree using a depth-first search.*/
-if(p->children.size()==0){
-//Base case: if leaf is found, just print the accumulated path
-ostr << "General Outcomes for path:";
-	for(int i = 1;i<path.size();i++){
-		ostr << ' ' << path[i]->item;
-	};
-	ostr << std::endl;
-	typename std::map<T,float>::iterator itr;
-	for(itr = p->outcome_certainties.begin();itr!=p->outcome_certainties.end();itr++){
-		ostr << "   "<< itr->first << ' ' << itr->second << std::endl;
-	};
-
-};
-for(int i=0;i<p->children.size();i++){
-	/*Continue searching down each of the children.*/
-	std::vector<DecisionTreeNode<T>* > copy = path;
-	copy.push_back(p->children[i]);
-	print_all_paths(ostr, p->children[i], copy);
-};
-}
-
-	
-template <class T> void DecisionTree<T>::print_all_paths(std::ostream& ostr)const{
-//DRIVER FOR PRINT_ALL_PATHS
-std::vector<DecisionTreeNode<T>*> path;
-path.push_back(root);
-this->print_all_paths(ostr,root,path);
-}
-
-
-
-template <class T>
-void DecisionTree<T>::get_best_paths(const std::vector<T>& query, 
-			const std::vector<DecisionTreeNode<T>* >& current_path,
-			std::vector<std::vector<DecisionTreeNode<T>* > >& best_paths, float& best_certainty,
-			DecisionTreeNode<T>* p, std::vector<T>& outcomes)const{
-	/*This recursive function is a utility for the "print_best_paths_for_query" function. Using a depth-first
-	 * search, for those paths that match the query in whatever order, even if a truncated version of the path
-	 * the query suggests, the certainty of the outcome of that path is evaluated. The highest certainty and 
-	 * its outcome is appropriately tracked.*/
-if(!p){
-	return;
-};
-if(p->children.size()==0){
-	//BASE CASE
-	/* If a path that adheres to the query has reached a leaf, then evaluate its certainty and outcomes.*/
-	typename std::map<T,float>::iterator itr;
-	float max_certainty = 0;
-	T certainty_elem;
-	for(itr = p->outcome_certainties.begin();itr!=p->outcome_certainties.end();itr++){
-		//Find max certainty of outcomes at this node
-		if(itr->second > max_certainty){
-			certainty_elem = itr->first;
-			max_certainty = itr->second;	
-		};
-	};
-	if(max_certainty == best_certainty){
-	/*If merely equal, then can add path to best paths*/
-	outcomes.push_back(certainty_elem);
-	best_paths.push_back(current_path);
-	}
-	else if(max_certainty > best_certainty){
-	//If higher, clear best_paths and add this path to best_path to set new standard of certainty
-	best_paths.clear();
-	outcomes.clear();
-	best_certainty = max_certainty;
-	outcomes.push_back(certainty_elem);
-	best_paths.push_back(current_path);
-	};
-};
-//only continue searching path if next entry is in query as well
-for(int i=0;i<p->children.size();i++){
-	if(std::find(query.begin(),query.end(),p->children[i]->item) != query.end()){
-	std::vector<DecisionTreeNode<T>* > copy = current_path;
-	copy.push_back(p->children[i]);
-	get_best_paths(query, copy, best_paths, best_certainty, p->children[i],outcomes);
-	};
-};
-}
-
-
-
-template <class T> 
-bool DecisionTree<T>::is_rearranged_path(const std::vector<std::vector<DecisionTreeNode<T>* > >& best_paths,
-					const std::vector<DecisionTreeNode<T>* > path)const{
-/* This function merely asserts whether the path has multiple variations for all those identified.
- * If there is no other path that is a mere re-arrangement of the one passed in, then it is a unique
- * path and false is returned.*/
-std::vector<DecisionTreeNode<T>* > path_copy = path;
-std::sort(path_copy.begin(),path_copy.end());
-std::vector<DecisionTreeNode<T>* > copy_util;
-for(int i=0;i<best_paths.size();i++){
-	if(best_paths[i].size()==path.size()){
-		copy_util = best_paths[i];
-		std::sort(copy_util.begin(),copy_util.end());
-		//Sort then check every index => O(nlogn)
-		bool is_same=true;
-		for(int j=0;j<copy_util.size();j++){
-			if(copy_util[i]!=path_copy[i]){
-				is_same =false;
-				break;
-			};
-		};
-		if(is_same){
-			return true;
-		};
-	};
-};
-return false;
-	
-}
-
-template <class T>
-void DecisionTree<T>::print_best_paths_for_query(const std::vector<T>& query)const{
-	/*This function prints the paths that lead to the most "certain" outcome for a 
-	 * certain query. Note that it will print only those paths with the highest
-	 * certainty, so unless there is a tie for the highest certainty among several
-	 * paths, it will output only one path.*/
-	std::vector<std::vector<DecisionTreeNode<T>* > > best_paths;
-	std::vector<DecisionTreeNode<T>*> starter_path;
-	starter_path.push_back(root);
-	float best_certainty = -1.0;
-	std::vector<T> outcomes;
-	//Pass "best_paths" in as reference to recursive utility
-	this->get_best_paths(query, starter_path, best_paths, best_certainty, root,outcomes);
-	if(best_paths.size()==0){
-		/*If no paths beat the best_certainty of -1, then no paths matched the query as a path has 
-		 at least a certainty of 0.*/
-		std::cerr << "No outcomes matched the conditions in the input query." << std::endl;
-		exit(1);
-	};
-	//need to print only unique paths 
-	std::cout << "For best_certainty of " << std::setprecision(3)
-	       	<< (float)best_certainty << " with root_condition of " <<
-		best_paths[0][0]->item << std::endl;
-	std::vector<std::vector<DecisionTreeNode<T>* > > final_best_paths;
-	for(int i=0;i<best_paths.size();i++){
-		if(!is_rearranged_path(final_best_paths,best_paths[i])){
-			//If the path is not one that we have already seen, then add it to final paths
-			final_best_paths.push_back(best_paths[i]);
-		};
-	};	
-	//Print the paths with the associated outcome and its certainty
-	for(int i=0;i<final_best_paths.size();i++){
-		std::cout << "Outcome of " << outcomes[i] << " with the following features:\n";
-		for(int j=1;j<final_best_paths[i].size();j++){
-			std::cout << "   Condition " <<final_best_paths[i][j]->parent_condition 
-			       << ": " <<final_best_paths[i][j]->item << std::endl;
-		};
-		std::cout << std::endl;
-	};
-}
-
-
-template<class T> void DecisionTree<T>::print_sideways
-(std::ostream& ostr,DecisionTreeNode<T>* p, int depth) const {
-   /* The print_sideways function prints the tree to a stream and 
-    * represents the structure of the tree along with all the keys 
-    * associated with each node. It is accomplished using an in-order
-    * traversal of each node.*/
-    if(!p->children.size()==0){ 
-	    //Left 
-    for(int i=0;i<p->children.size()/2;i++){
-	      print_sideways(ostr, p->children[i], depth+1);	      
-    };
-    //Root
-    ostr << std::string(depth,'\t');
-	ostr<<p->item;
-    ostr << std::endl;
-    //Right
-    if(!p->children.size()==0){
-    for(int i=p->children.size()/2;i<p->children.size();i++){
-	      print_sideways(ostr, p->children[i], depth+1);	      
-    };
-    };
-   };
-
-}
-
-template <class T>
-void DecisionTree<T>::destroy_tree(DecisionTreeNode<T>* p){
-/*This recursive function is a simple utility for the destructor. Using
- * a depth-first search, we delete the node once only if all its children 
- * have been deleted.*/
-if(p){
-for(int i=0;i<p->children.size();i++){
-	destroy_tree(p->children[i]);
-};
-delete p;
-};
-}
-
-
+#include <string>
+#include <iostream>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <memory_resource>
+#include <unordered_map>
+#include "table.h"
+#include "bitmap.h"
+#include "cube.h"
+#include "thread_pool.h"
+/*This header file is comprised by the DecisionTree class and its utility node
+ * class. The decision tree, in general, is a tool to examine possible outcomes 
+ * relative to established precedents in order to ultimately, as the name suggests,
+ * make a decision. The implementation of the decision tree here is a non-binary tree
+ * that propagates with the nodes having children. When a node does not have a child, there
+ * are no more possibilities to explore an outcome of some degree of certainty is found. Per
+ * a data table that the user provides, the decision tree is constructed, and the user can then
+ * examine all outcomes that fit a custom query. Note that the tree is built on a dictionary-encoded
+ * copy of the data table (see table.h), so every feature held by a node is a code that is only
+ * decoded back into the feature when the tree prints.*/
+enum CountingMode{
+	SCAN_ROWS,
+	//Every count rescans all the rows of the table (the default)
+	BITMAP_INDEX,
+	//Every count ands the bitmaps of the features on the path and counts the bits (see bitmap.h)
+	ROW_SUBSETS,
+	//Every node passes the rows that match its path down to its children, which only narrow them
+	CONTINGENCY_CUBE
+	//Every count adds up the cells of a cube of the counts of every combination of features (see cube.h)
+};
+
+struct TreeOptions{
+	/*The options that decide how a DecisionTree is built. "counting", "threads", "serial_cutoff" and
+	 * "memory" only change the work that goes into building it. "share_permutations" changes the shape of
+	 * the tree (a lattice with fewer nodes), and "lazy" leaves nodes unbuilt until a query reaches them,
+	 * though the paths and outcomes found are the same with either of them.*/
+	CountingMode counting;
+	//How the outcomes of every new node are counted
+	int threads;
+	//The number of worker threads that build subtrees (1 builds on the calling thread)
+	int serial_cutoff;
+	//Subtrees with at most this many conditions left to branch on are built serially
+	bool share_permutations;
+	//Whether every order of the same set of features shares one node (the tree becomes a lattice)
+	std::pmr::memory_resource* memory;
+	//Where the tree's arenas get their memory from (NULL for new and delete)
+	bool lazy;
+	/*Whether the children of a node are only built once a query first reaches it (the tree is then
+	 * built serially, one node at a time, and "share_permutations" is not used)*/
+	TreeOptions(){counting=SCAN_ROWS;threads=1;serial_cutoff=2;share_permutations=false;memory=NULL;lazy=false;}
+};
+
+struct CountCache{
+	/*The counts that several trees built on the same table share. The certainties of the features
+	 * of a condition only depend on the set of features already on the path, not on the order they
+	 * were found in or the root the path started from, so every tree of a DecisionForest can reuse
+	 * the counts of the others.*/
+	std::mutex lock;
+	std::map<std::vector<int>, std::map<int,std::map<int,float> > > certainties;
+	//The certainties keyed by the set of features on the path (see "lattice_key") and the new condition
+};
+
+template <class T>
+struct QueryPath{
+	//One of the paths that best match a query, decoded
+	T outcome;
+	//The most certain outcome at the end of the path
+	std::vector<std::pair<T,T> > features;
+	//The condition and the feature of every node on the path below the root
+};
+
+template <class T>
+struct QueryResult{
+	/*What "print_best_paths_for_query" prints, handed back rather than printed.*/
+	bool matched;
+	//Whether any path of the tree matched the query
+	float certainty;
+	//The certainty of the best paths
+	int root_condition_index;
+	T root_condition;
+	//The condition at the root of the tree that answered
+	std::vector<QueryPath<T> > paths;
+	//The best paths, without the ones that are re-arrangements of another
+	QueryResult(){matched=false;certainty=-1;root_condition_index=-1;}
+	bool supported()const;
+	//Whether a path with at least one feature (and so "min_occurences" rows) matched the query
+};
+
+template <class T>
+bool QueryResult<T>::supported()const{
+	for(int i=0;i<paths.size();i++){
+		if(paths[i].features.size()>0){
+			return true;
+		};
+	};
+	return false;
+}
+
+class QueryMask{
+	/*An encoded query compiled once per search: a bit for every code of every condition, set when the
+	 * query has that feature, and the codes of every condition in order. Whether a child follows the
+	 * query is then one bit test, and a node with many children looks up the few children that follow the
+	 * query among its sorted children rather than testing every one of them (see "for_each_match").*/
+	private:
+	//MEMBER VARIABLES
+	std::vector<std::vector<uint64_t> > bits;
+	//The bits of the codes of every condition
+	std::vector<std::vector<int> > codes;
+	//The codes of every condition that the query has, in order and without repeats
+	int num_codes;
+	//The number of codes in "codes"
+
+	public:
+	//CONSTRUCTORS
+	QueryMask(){num_codes=0;}
+	QueryMask(const std::vector<std::vector<int> >& query){compile(query);}
+	//MODIFIERS
+	void compile(const std::vector<std::vector<int> >& query);
+	//Compiles a query, reusing the memory of the query compiled before
+	//ACCESSORS
+	bool has(int condition, int code)const{
+		return code>=0 && (code>>6)<bits[condition].size() && (bits[condition][code>>6]>>(code&63)&1);
+	}
+	//UTILITIES
+	template <class Key, class Visit>
+	void for_each_match(int num_children, Key key, Visit visit)const;
+	/*Calls "visit" with every child (from 0 to "num_children") whose condition and feature, as "key" gives
+	 * them, the query has, in the order of the children, which are sorted by condition and then feature*/
+};
+
+inline void QueryMask::compile(const std::vector<std::vector<int> >& query){
+	bits.resize(query.size());
+	codes.resize(query.size());
+	num_codes = 0;
+	for(int i=0;i<query.size();i++){
+		codes[i].assign(query[i].begin(),query[i].end());
+		std::sort(codes[i].begin(),codes[i].end());
+		codes[i].erase(std::unique(codes[i].begin(),codes[i].end()),codes[i].end());
+		num_codes += codes[i].size();
+		bits[i].assign(codes[i].empty() ? 0 : (codes[i].back()>>6)+1,0);
+		for(int j=0;j<codes[i].size();j++){
+			bits[i][codes[i][j]>>6] |= (uint64_t)1<<(codes[i][j]&63);
+		};
+	};
+}
+
+template <class Key, class Visit>
+void QueryMask::for_each_match(int num_children, Key key, Visit visit)const{
+	/*Testing a child is a bit test, so a node is scanned unless it has many more children than the query
+	 * has codes, in which case every code of the query is found among the children with a binary search.
+	 * The children come out in the same order either way.*/
+	if(num_children<=16 || num_children<=4*num_codes){
+		for(int i=0;i<num_children;i++){
+			std::pair<int,int> child = key(i);
+			if(has(child.first,child.second)){
+				visit(i);
+			};
+		};
+		return;
+	};
+	int low = 0;
+	for(int condition=0;condition<codes.size();condition++){
+		for(int j=0;j<codes[condition].size();j++){
+			std::pair<int,int> wanted(condition,codes[condition][j]);
+			int high = num_children;
+			while(low<high){
+				int middle = low+(high-low)/2;
+				if(key(middle)<wanted){
+					low = middle+1;
+				}
+				else{
+					high = middle;
+				};
+			};
+			if(low<num_children && key(low)==wanted){
+				visit(low);
+				low++;
+			};
+		};
+	};
+}
+
+class LockedResource : public std::pmr::memory_resource{
+	/*A memory resource that serializes every call to another resource, so that the arenas of a
+	 * parallel build can share a resource that is not thread-safe.*/
+	private:
+	std::pmr::memory_resource* upstream;
+	std::mutex lock;
+	void* do_allocate(size_t bytes, size_t alignment){
+		std::lock_guard<std::mutex> guard(lock);
+		return upstream->allocate(bytes,alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment){
+		std::lock_guard<std::mutex> guard(lock);
+		upstream->deallocate(p,bytes,alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other)const noexcept{return this==&other;}
+	public:
+	LockedResource(std::pmr::memory_resource* r){upstream = r;}
+};
+
+template <class N>
+struct PathSearch{
+	/*The state of a search for the best paths of a query. The path being searched is one stack that every
+	 * step of the search pushes to and pops from, and the best paths are kept end to end in one vector,
+	 * so once a search has grown these vectors, the next search that reuses them allocates nothing. The
+	 * nodes are whatever identifies them (the pointers of a DecisionTree or the indices of a
+	 * FrozenDecisionTree).*/
+	std::vector<N> path;
+	//The path from the root to the node being searched
+	std::vector<N> best_nodes;
+	//The nodes of every best path, one path after another
+	std::vector<int> best_ends;
+	//Where every best path ends in "best_nodes"
+	std::vector<int> outcomes;
+	//The most certain outcome at the end of every best path
+	float best_certainty;
+	//The certainty of the best paths (-1 until a path is found)
+	PathSearch(){best_certainty=-1;}
+	void reset(N root);
+	//Starts a new search from the root, keeping the memory of the vectors
+	void weigh(const std::vector<N>& current_path, float certainty, int outcome);
+	//Keeps a path that ends in a leaf if it is at least as certain as the best paths so far
+	int num_paths()const{return best_ends.size();}
+	int path_begin(int i)const{return i==0 ? 0 : best_ends[i-1];}
+	int path_end(int i)const{return best_ends[i];}
+	//Where the i-th best path starts and ends in "best_nodes"
+	std::vector<int> distinct;
+	//The best paths that "distinct_paths" keeps
+	std::vector<std::pair<uint64_t,int> > fingerprints;
+	//An open-addressed table of the fingerprints of the kept paths and their indices (-1 in an empty slot)
+	std::vector<std::pair<int,int> > pairs;
+	std::vector<std::pair<int,int> > other;
+	//The sorted pairs of two paths that have the same fingerprint
+	template <class Key>
+	const std::vector<int>& distinct_paths(Key key);
+	/*The best paths that are not re-arrangements of an earlier best path, where "key" gives the condition and
+	 * the feature of a node (the memory of the vectors it uses is kept, as for the search)*/
+};
+
+template <class N>
+void PathSearch<N>::reset(N root){
+	path.clear();
+	path.push_back(root);
+	best_nodes.clear();
+	best_ends.clear();
+	outcomes.clear();
+	best_certainty = -1;
+}
+
+inline uint64_t path_pair_hash(const std::pair<int,int>& pair){
+	//Mixes the condition and the feature of a node into 64 well spread bits (the finalizer of splitmix64)
+	uint64_t h = ((uint64_t)(uint32_t)pair.first<<32 | (uint32_t)pair.second)+0x9E3779B97F4A7C15ULL;
+	h = (h^(h>>30))*0xBF58476D1CE4E5B9ULL;
+	h = (h^(h>>27))*0x94D049BB133111EBULL;
+	return h^(h>>31);
+}
+
+template <class N>
+template <class Key>
+const std::vector<int>& PathSearch<N>::distinct_paths(Key key){
+	/*Two paths are re-arrangements of each other when they hold the same set of conditions and features.
+	 * Every path gets a fingerprint that does not depend on the order of its nodes (the sum and the xor of
+	 * the hashes of its pairs, along with its length), so a path is only compared with the kept paths of
+	 * the same fingerprint, and then pair by pair in sorted order to rule out a collision. Finding the
+	 * distinct paths is therefore linear in the number of best paths, however many of them tie. The
+	 * fingerprints are kept in a table with at least twice as many slots as there are paths, which is
+	 * searched from the slot the fingerprint picks to the next empty slot.*/
+	distinct.clear();
+	size_t num_slots = 1;
+	while(num_slots<2*(size_t)num_paths()){
+		num_slots *= 2;
+	};
+	fingerprints.assign(num_slots,std::make_pair((uint64_t)0,-1));
+	for(int i=0;i<num_paths();i++){
+		uint64_t sum = 0;
+		uint64_t mix = 0;
+		for(int j=path_begin(i);j<path_end(i);j++){
+			uint64_t h = path_pair_hash(key(best_nodes[j]));
+			sum += h;
+			mix ^= h;
+		};
+		uint64_t fingerprint = sum^(mix<<1 | mix>>63)^((uint64_t)(path_end(i)-path_begin(i))*0x9E3779B97F4A7C15ULL);
+		size_t slot = fingerprint&(num_slots-1);
+		bool rearranged = false;
+		bool sorted = false;
+		for(;fingerprints[slot].second>=0 && !rearranged;slot=(slot+1)&(num_slots-1)){
+			if(fingerprints[slot].first!=fingerprint){
+				continue;
+			};
+			if(!sorted){
+				pairs.clear();
+				for(int j=path_begin(i);j<path_end(i);j++){
+					pairs.push_back(key(best_nodes[j]));
+				};
+				std::sort(pairs.begin(),pairs.end());
+				sorted = true;
+			};
+			other.clear();
+			for(int j=path_begin(fingerprints[slot].second);j<path_end(fingerprints[slot].second);j++){
+				other.push_back(key(best_nodes[j]));
+			};
+			std::sort(other.begin(),other.end());
+			rearranged = pairs==other;
+		};
+		if(!rearranged){
+			//the search stopped at an empty slot, which the path takes
+			distinct.push_back(i);
+			fingerprints[slot] = std::make_pair(fingerprint,i);
+		};
+	};
+	return distinct;
+}
+
+template <class N>
+void PathSearch<N>::weigh(const std::vector<N>& current_path, float certainty, int outcome){
+	/*A more certain path replaces the best paths, and a path that is merely as certain is added to them.*/
+	if(certainty > best_certainty){
+		best_nodes.clear();
+		best_ends.clear();
+		outcomes.clear();
+		best_certainty = certainty;
+	};
+	if(certainty == best_certainty){
+		best_nodes.insert(best_nodes.end(),current_path.begin(),current_path.end());
+		best_ends.push_back(best_nodes.size());
+		outcomes.push_back(outcome);
+	};
+}
+
+template <class T>
+class DecisionTreeNode{
+	/*This class represents the nodes that make up a decision tree. It stores
+	 * important information regarding potential outcomes and the subsequent nodes
+	 * to which it points, its children. Note that everything is left public as the
+	 * user is not supposed to access this class, and it is only used in constructing
+	 * the decision tree. The children and outcomes of a node are kept in memory from the
+	 * resource that the node itself was allocated from (the tree's arena).*/
+	public:
+	//CONSTRUCTORS
+	DecisionTreeNode(int p, int i, const std::map<int,float>& c,
+			std::pmr::memory_resource* r=std::pmr::get_default_resource())
+			:children(r),outcome_certainties(c.begin(),c.end(),r)
+			{item = i; parent_condition=p;parent=NULL;expanded=true;max_certainty=-1;}
+	DecisionTreeNode(int p, std::pmr::memory_resource* r=std::pmr::get_default_resource())
+			:children(r),outcome_certainties(r){item = -1; parent_condition=p;parent=NULL;expanded=true;max_certainty=-1;}
+
+	//Member variables
+	std::pmr::vector<DecisionTreeNode<T>*> children;
+	//Pointers to subseqent nodes
+	int item;
+	//The code of the feature that describes the condition the node represents (-1 for the root)
+	int parent_condition;
+	//The index of the condition to which the feature refers
+	DecisionTreeNode<T>* parent;
+	//The parent node
+	std::pmr::map<int, float> outcome_certainties;
+	//All possible outcomes (by code) at this node from its path and their certainties (% occurence)
+	bool expanded;
+	//Whether the children of the node have been built (only ever false in the lazy mode)
+	float max_certainty;
+	/*The highest certainty of any leaf below the node (1 for a node whose children are not built yet, and
+	 * -1 until it is worked out, see "bound_subtree")*/
+};
+	
+	
+template <class T>
+class FrozenDecisionTree;
+template <class T>
+class DecisionForest;
+
+template <class T>
+class DecisionTree{
+	/* This class represents a decision tree. Comprised of a series of DecisionTreeNode's,
+	 * each node in the tree is dynamically allocated memory and properly de-allocated once
+	 * the DecisionTree goes out of scope. In terms of the behavior of the tree, the tree will
+	 * examine all possible combinations of conditions by forming paths in the tree, but once a
+	 * certain degree of certainty is found, the node is "pruned" so as not to overfit the data.
+	 * This degree of certainty can be specified by the user, as well as the minimum number of
+	 * occurences an outcome needs in order to be valid, another safety net to avoid overfitting.
+	 * Ultimately, the DecisionTree class forms all paths that will lead to the certainty the user
+	 * is looking for provided there is a path as such that exists. */ 
+	private:
+	//MEMBER VARIABLES
+	std::atomic<int> size_;
+	//To track the size of the tree (subtrees may be built on several threads)
+	int min_occurences;
+	//Minimum number of occurences an outcome needs (overfitting avoidance)	
+	float prune_certainty;
+	//Certainty at which pruning occurs (overfitting avoidance)
+	DecisionTreeNode<T>* root;
+	//The root node of the tree (all other nodes can be accessed from the root)
+	std::shared_ptr<EncodedTable<T> > own_table;
+	//The tree's own copy of its table, which "add_rows" and "remove_rows" change (NULL for the trees of a forest)
+	std::shared_ptr<const EncodedTable<T> > shared_table;
+	//The table the tree is built on, which the trees of a DecisionForest share
+	std::map<std::vector<int>, std::vector<int> > rows_of_codes;
+	/*The rows of "own_table" with the codes of every distinct row, made by the first "remove_rows" and
+	 * made again after new features change the codes (empty until then)*/
+	const EncodedTable<T>& table;
+	//The dictionary-encoded data table the tree is built on (sorted, see "sorted_table")
+	TreeOptions options;
+	//The options the tree is built with
+	std::shared_ptr<const BitmapIndex> index;
+	//The bitmap index of the table (only built for the BITMAP_INDEX counting mode)
+	std::shared_ptr<const ContingencyCube> cube;
+	//The contingency cube of the table (only built for the CONTINGENCY_CUBE counting mode)
+	std::shared_ptr<CountCache> count_cache;
+	//The counts shared with the other trees of a DecisionForest (NULL for a tree on its own)
+	std::unique_ptr<WorkStealingPool> pool;
+	//The workers that build subtrees in parallel (only while a parallel build is running)
+	std::map<std::vector<int>, DecisionTreeNode<T>*> lattice;
+	/*With "share_permutations", the node of every set of features keyed by the feature of each
+	 * condition (-1 where the condition is not in the set); NULL marks a set that was counted but
+	 * did not make a node. This node is the only one that builds the subtree of the set.*/
+	std::map<std::vector<int>, DecisionTreeNode<T>*> lattice_aliases;
+	/*The nodes of the same sets reached with a different condition last, keyed by the set followed by
+	 * that condition. They carry their own feature for printing, and their children are linked to
+	 * the children of the set's node once the build is done.*/
+	std::mutex lattice_lock;
+	//Guards "lattice" and "lattice_aliases" during a parallel build
+	std::unique_ptr<LockedResource> locked_memory;
+	//Serializes the user's memory resource when it is shared by the arenas of a parallel build
+	mutable std::mutex expand_lock;
+	//Makes the expansions of a lazy tree one at a time, so that a tree can be queried by several threads
+	std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource> > arenas;
+	/*The arenas every node, child list and outcome map is allocated from: one for the thread that
+	 * constructs the tree and one per worker of a parallel build. The tree is torn down by releasing
+	 * them.*/
+	std::vector<std::unique_ptr<LockedResource> > locked_arenas;
+	/*In a parallel build, the arenas as the nodes see them. A worker that steals a subtree adds children
+	 * to a node that another worker made, from that worker's arena, so every arena is serialized.*/
+	
+	//UTILITIES
+	void print_sideways(std::ostream& ostr,DecisionTreeNode<T>* p, int depth)const;	
+	//A recursive utility for the "print_sideways" public option
+
+	int build_decision_tree(DecisionTreeNode<T>* p, const std::vector<int>& conditions_found,
+			const std::vector<int>& features_path,int root_condition_index,
+			const std::vector<int>& rows);
+	//A utility for the constructor, this builds the decision tree in a depth-first fashion
+
+	std::pmr::memory_resource* arena()const;
+	//The arena of the thread that is running (nodes are only allocated while the tree is built)
+	template <class... Args>
+	DecisionTreeNode<T>* make_node(Args... args);
+	//Allocates and constructs a node in the arena of the running thread
+	std::vector<int> lattice_key(const std::vector<int>& conditions_found, const std::vector<int>& features_path)const;
+	//Makes the key of a set of features in "lattice", which is the same for every order of the features
+	bool link_shared_children(DecisionTreeNode<T>* p, const std::vector<int>& conditions_found,
+			const std::vector<int>& features_path, int condition);
+	//Links the nodes of every feature of a condition below "p" if all of them were already counted
+	DecisionTreeNode<T>* shared_node(const std::vector<int>& key, int condition, int& added);
+	//Returns the node of an already built set of features that ends with the given condition
+	void link_lattice_aliases();
+	//Gives every alias in "lattice_aliases" the children of its set's node once the build is done
+	void expand(DecisionTreeNode<T>* p)const;
+	//In the lazy mode, builds the children of a node the first time a query reaches it
+	void expand_all(DecisionTreeNode<T>* p)const;
+	//In the lazy mode, builds every node below "p" that has not been built yet
+	float bound_subtree(DecisionTreeNode<T>* p)const;
+	//Works out the "max_certainty" of "p" and of every node below it that does not have one yet
+	std::vector<int> rows_of_path(const std::vector<int>& conditions_found, const std::vector<int>& features_path)const;
+	//The rows that match the features of a path (for the ROW_SUBSETS mode, which does not keep them)
+	void update(const std::vector<int>& changed, bool new_features);
+	//Brings the tree up to date once the weights of the "changed" rows of the table have changed
+	void update_node(DecisionTreeNode<T>* p, const std::vector<int>& conditions_found,
+			const std::vector<int>& features_path, const std::vector<int>& rows, const std::vector<int>& changed);
+	/*Updates the children of "p" whose counts the changed rows (which all match the path to "p") are in
+	 * ("rows" is as in "build_decision_tree")*/
+	int subtree_size(const DecisionTreeNode<T>* p)const;
+	//The number of nodes in the subtree of "p", "p" included
+	void remap_codes(DecisionTreeNode<T>* p, const std::vector<std::vector<int> >& remap);
+	//Renumbers the features and outcomes of every node below "p" once the codes of the table are sorted again
+	void rebuild();
+	//Builds the whole tree again on the table as it is (used for a lattice)
+
+
+	std::map<int,std::map<int, float> > get_certainties(const std::vector<int>& prior_features,
+			const std::vector<int>& feature_indices, const std::vector<int>& rows,
+			std::vector<std::vector<int> >& feature_rows);
+	//A recursive utiltiy to "get_certainties"'s public option
+	void count_by_scan(const std::vector<int>& prior_features, const std::vector<int>& feature_indices,
+			std::vector<int>& outcomes)const;
+	void count_by_bitmaps(const std::vector<int>& prior_features, const std::vector<int>& feature_indices,
+			std::vector<int>& outcomes)const;
+	void count_by_subset(const std::vector<int>& rows, int new_condition, std::vector<int>& outcomes,
+			std::vector<std::vector<int> >& feature_rows)const;
+	//Utilities for "get_certainties" that count the outcomes of every feature of the new condition
+	void print_all_paths(std::ostream& ostr, DecisionTreeNode<T>* p,
+		       	std::vector<DecisionTreeNode<T>* >& path)const;
+	//A recursive utility "print_all_paths"'s public option 
+
+	void get_best_paths(const QueryMask& query, PathSearch<DecisionTreeNode<T>*>& search,
+				DecisionTreeNode<T>* p)const;
+	//A recursive utility "print_best_paths_for_query"'s public option 
+	void get_best_paths(const std::vector<QueryMask>& queries, std::vector<int>& active, int first_active,
+				std::vector<DecisionTreeNode<T>*>& current_path,
+				std::vector<PathSearch<DecisionTreeNode<T>*> >& searches, DecisionTreeNode<T>* p)const;
+	/*The same search for several queries at once, keeping the best paths of each of the queries that are
+	 * active (from "first_active" to the end of "active")*/
+	QueryResult<T> make_result(PathSearch<DecisionTreeNode<T>*>& search)const;
+	//Decodes the best paths of a query, leaving out the ones that are re-arrangements of another
+	void print_path_to_parent(DecisionTreeNode<T>* p)const;
+	//A private utility for debugging to print the path to the root node
+	const T& item_name(const DecisionTreeNode<T>* p)const;
+	//Decodes the feature of a node (the root is named after its condition)
+	void init(int root_condition_index,int min_occur, float prune);
+	//A utility for the constructors that builds the tree once the table is encoded
+	static std::shared_ptr<EncodedTable<T> > sorted_table(EncodedTable<T> data);
+	//Sorts the codes of a table so that the children of every node come in the order of their features
+	DecisionTree(const std::shared_ptr<const EncodedTable<T> >& data, const std::shared_ptr<const BitmapIndex>& idx,
+			const std::shared_ptr<const ContingencyCube>& cb, const std::shared_ptr<CountCache>& counts,
+			int root_condition_index, int min_occur, float prune, const TreeOptions& opts);
+	//Builds one tree of a DecisionForest on the table, index, cube and counts of the forest
+	friend class DecisionForest<T>;
+
+	public:
+	//CONSTRUCTORS
+	DecisionTree(const std::vector<T>& conditions, const std::vector<std::vector<T> >& data,
+	       	int root_condition_index,int min_occur, float prune, const TreeOptions& opts=TreeOptions());
+	DecisionTree(const EncodedTable<T>& data, int root_condition_index,int min_occur, float prune,
+			const TreeOptions& opts=TreeOptions());
+	//ACCESSORS
+	int get_size()const{return size_;}
+	/*The number of nodes (with "share_permutations", each set of features is only counted once per last
+	 * condition, and in the lazy mode, only the nodes built so far are counted)*/
+	const EncodedTable<T>& get_table()const{return table;}
+	//MODIFIERS
+	void add_rows(const std::vector<std::vector<T> >& rows);
+	/*Adds rows to the tree's own copy of the table and updates the nodes whose paths they match, as if the
+	 * tree had been built with them (the table that "get_table" returns changes with it)*/
+	int remove_rows(const std::vector<std::vector<T> >& rows);
+	/*Takes rows out of the tree's own copy of the table (a row given twice is taken out twice) and updates
+	 * the nodes whose paths they matched, returning the number of rows that were found in the table*/
+
+	//PUBLIC UTILITIES
+	QueryResult<T> query(const std::vector<T>& query)const;
+	//Finds the paths that generate the highest degree of certainty without printing them
+	std::vector<QueryResult<T> > query_all(const std::vector<std::vector<T> >& queries)const;
+	//Finds what "query" finds for every query, in one traversal of the tree
+	void print_best_paths_for_query(const std::vector<T>& query)const;
+	//Prints the paths that generate the highest degree of certainty
+	void print_sideways(std::ostream& ostr)const;
+	//A utility to print the shape of the tree sideways (Note this does not work well with many children)
+	void print_all_paths(std::ostream& ostr)const;
+	//A utility print all the paths in the tree from the root if tree cannot be visualized with "print_sideways"
+	FrozenDecisionTree<T> freeze()const;
+	//Lays the finished tree out in a compact array for queries (see FrozenDecisionTree)
+	
+	//DESTRUCTOR
+	~DecisionTree();
+};
+
+template <class T>
+void DecisionTree<T>::print_path_to_parent(DecisionTreeNode<T>* p)const{
+	/*This function simply prints the path to the root from the node passed in.
+	 * It is not publicly available and was used for debugging.*/
+	DecisionTreeNode<T>* temp = p;
+	while(temp->parent){
+	std::cout<< item_name(temp) << ' ';
+	temp=temp->parent;
+	};
+}
+
+
+
+template <class T>
+const T& DecisionTree<T>::item_name(const DecisionTreeNode<T>* p)const{
+	/*The root of the tree has no feature of its own, so it goes by the name of its condition.*/
+	if(p->item<0){
+		return table.condition(p->parent_condition);
+	};
+	return table.decode(p->parent_condition, p->item);
+}
+
+template <class T>
+typename std::map<int,std::map<int,float> >
+DecisionTree<T>::get_certainties(const std::vector<int>& prior_features, const std::vector<int>& feature_indices,
+			const std::vector<int>& rows, std::vector<std::vector<int> >& feature_rows){
+	/*This function asserts the likely outcomes of the features provided. This is done by passing in a vector
+	 * of indices that represent the features also passed in as codes, but an extra index in 
+	 * "feature_indices" represents the new outcome that we would like to assert. Essentially, the function
+	 * is characterized by the question: *How many times do the things found out these indices occur as the
+	 *  combination shown in the features? In the ROW_SUBSETS mode, "rows" holds the rows that match the
+	 *  prior features, and the rows of every feature of the new condition are handed back in "feature_rows".*/
+	int new_condition = feature_indices.back();
+	//take the most recently added index
+	std::vector<int> cache_key;
+	if(count_cache && options.counting!=ROW_SUBSETS){
+		/*Another tree of the forest may have counted the same set of features already. The ROW_SUBSETS
+		 * mode is left out, as its children need the rows of every feature and not only the counts.*/
+		cache_key = lattice_key(feature_indices,prior_features);
+		cache_key.push_back(new_condition);
+		std::lock_guard<std::mutex> guard(count_cache->lock);
+		typename std::map<std::vector<int>,std::map<int,std::map<int,float> > >::const_iterator cached
+			= count_cache->certainties.find(cache_key);
+		if(cached!=count_cache->certainties.end()){
+			return cached->second;
+		};
+	};
+	int num_outcomes = table.symbols(table.outcome_column()).size();
+	std::vector<int> outcomes(table.symbols(new_condition).size()*num_outcomes,0);
+	//number of results for each outcome (inner) for each feature of the new condition (outer)
+	if(options.counting==BITMAP_INDEX){
+		count_by_bitmaps(prior_features,feature_indices,outcomes);
+	}
+	else if(options.counting==ROW_SUBSETS){
+		count_by_subset(rows,new_condition,outcomes,feature_rows);
+	}
+	else if(options.counting==CONTINGENCY_CUBE){
+		cube->marginalize(prior_features,feature_indices,table.outcome_column(),outcomes);
+	}
+	else{
+		count_by_scan(prior_features,feature_indices,outcomes);
+	};
+	std::map<int,std::map<int,float> > ret_certainties;
+	for(int feature=0;feature<table.symbols(new_condition).size();feature++){
+		/*Here, we check if the outcomes meet the rquirement specified by "min_occurences"*/
+		const int* counts = &outcomes[feature*num_outcomes];
+		int denom = 0;
+		for(int outcome=0;outcome<num_outcomes;outcome++){
+			denom+= counts[outcome];
+		};
+		if(denom==0 || denom < min_occurences){
+			//overfitting restriction => want at least this many occurences
+			continue;
+		};
+		std::map<int,float>& certainties = ret_certainties[feature];
+		for(int outcome=0;outcome<num_outcomes;outcome++){
+			if(counts[outcome]>0){
+				certainties[outcome] = (float)counts[outcome]/denom;
+			};
+		};
+	};
+	if(!cache_key.empty()){
+		std::lock_guard<std::mutex> guard(count_cache->lock);
+		count_cache->certainties.insert(std::make_pair(cache_key,ret_certainties));
+	};
+	return ret_certainties;
+	
+}
+
+template <class T>
+void DecisionTree<T>::count_by_scan(const std::vector<int>& prior_features,
+		const std::vector<int>& feature_indices, std::vector<int>& outcomes)const{
+	/*For every set of features in the data table, we want to see those instances that
+	 * adhere to the features specified. */
+	const std::vector<int>& new_column = table.column(feature_indices.back());
+	const std::vector<int>& outcome_column = table.column(table.outcome_column());
+	int num_outcomes = table.symbols(table.outcome_column()).size();
+	for(int i = 0;i<table.rows();i++){
+		bool candidate = true;
+		for(int j=0;j<prior_features.size();j++){
+			if(table.at(i,feature_indices[j]) != prior_features[j]){
+			/*If an entry for those indices in the data is not in our features,
+			 * then we don't need to examine that line of data.*/
+				candidate = false;
+				break;
+			};
+		};
+		if(candidate){
+			//If it is a candidate, we increment the outcome associated with the set of features
+			outcomes[new_column[i]*num_outcomes+outcome_column[i]] += table.weight(i);
+		};
+	};
+}
+
+template <class T>
+void DecisionTree<T>::count_by_bitmaps(const std::vector<int>& prior_features,
+		const std::vector<int>& feature_indices, std::vector<int>& outcomes)const{
+	/*The rows that match the path are the bitmaps of the features on the path and-ed together.
+	 * Each feature of the new condition narrows those rows once more, and the outcomes are then
+	 * counted by and-ing with the bitmap of every outcome. Features that cannot reach
+	 * "min_occurences" are skipped before their outcomes are counted. When the rows are weighted, the
+	 * weights of the rows that are left are added up rather than counted.*/
+	int words = index->num_words();
+	int new_condition = feature_indices.back();
+	int num_outcomes = table.symbols(table.outcome_column()).size();
+	std::vector<uint64_t> path(index->rows(),index->rows()+words);
+	for(int j=0;j<prior_features.size();j++){
+		bitmap_and_into(path.data(),path.data(),index->bitmap(feature_indices[j],prior_features[j]),words);
+	};
+	std::vector<uint64_t> feature_rows(words);
+	for(int feature=0;feature<table.symbols(new_condition).size();feature++){
+		int total = bitmap_and_into(feature_rows.data(),path.data(),
+				index->bitmap(new_condition,feature),words);
+		if(total>0 && !table.has_unit_weights()){
+			total = bitmap_weigh(feature_rows.data(),table.get_weights().data(),words);
+		};
+		if(total==0 || total < min_occurences){
+			continue;
+		};
+		for(int outcome=0;outcome<num_outcomes;outcome++){
+			if(table.has_unit_weights()){
+				outcomes[feature*num_outcomes+outcome] = bitmap_and_count(feature_rows.data(),
+						index->bitmap(table.outcome_column(),outcome),words);
+			}
+			else{
+				outcomes[feature*num_outcomes+outcome] = bitmap_and_weigh(feature_rows.data(),
+						index->bitmap(table.outcome_column(),outcome),table.get_weights().data(),words);
+			};
+		};
+	};
+}
+
+template <class T>
+void DecisionTree<T>::count_by_subset(const std::vector<int>& rows, int new_condition,
+		std::vector<int>& outcomes, std::vector<std::vector<int> >& feature_rows)const{
+	/*Only the rows that already matched the parent's path are examined, so the work at a node is
+	 * proportional to its support rather than to the size of the table. Each of those rows is
+	 * counted and split off into the rows of its feature for the children to narrow further.*/
+	const std::vector<int>& new_column = table.column(new_condition);
+	const std::vector<int>& outcome_column = table.column(table.outcome_column());
+	int num_outcomes = table.symbols(table.outcome_column()).size();
+	feature_rows.assign(table.symbols(new_condition).size(),std::vector<int>());
+	for(int i=0;i<rows.size();i++){
+		int feature = new_column[rows[i]];
+		outcomes[feature*num_outcomes+outcome_column[rows[i]]] += table.weight(rows[i]);
+		feature_rows[feature].push_back(rows[i]);
+	};
+}
+
+
+template <class T>
+int DecisionTree<T>::build_decision_tree(DecisionTreeNode<T>* p,
+		const std::vector<int>& conditions_found, const std::vector<int>& features_path,
+		int root_condition_index, const std::vector<int>& rows){
+	/* This function is a utility for the constructor and recursively builds the decision tree. Note that
+	 * "rows" is only used in the ROW_SUBSETS mode, where it holds the rows that match the path to "p".
+	 * The number of nodes added is returned; in a parallel build, the subtrees that are handed to the
+	 * pool add their own nodes to the size of the tree once they are built.*/
+	int added = 0;
+	if(!p){
+		//BASE CASE
+		return added;
+	};
+	for(int i=0;i<table.num_conditions();i++){
+		//for every possible condition (note that last entry, the outcome, is not considered)
+		if(std::find(conditions_found.begin(),conditions_found.end(),i)==conditions_found.end()){
+			if((conditions_found.size()==0&&i==root_condition_index)||conditions_found.size()>0){
+			/*If the condition has not been found, as in it is not on the current path, we can
+			 * create a new node.*/
+			std::vector<int> conditions_found_copy = conditions_found;
+			conditions_found_copy.push_back(i);
+			if(options.share_permutations && link_shared_children(p,conditions_found,features_path,i)){
+				//every node for this condition was already built along another order of the path
+				continue;
+			};
+			std::vector<std::vector<int> > feature_rows;
+			std::map<int,std::map<int,float> > certainties = get_certainties(features_path,
+					conditions_found_copy,rows,feature_rows);
+			typename std::map<int,std::map<int,float> >::iterator itr;
+			if(options.share_permutations){
+				/*The features that did not make a node are remembered as well, so that no other
+				 * order of the path has to count them again. Only those are marked here, as a
+				 * parallel build must never see a mark for a node that is about to be made.*/
+				std::vector<int> key = lattice_key(conditions_found,features_path);
+				std::lock_guard<std::mutex> guard(lattice_lock);
+				for(int feature=0;feature<table.symbols(i).size();feature++){
+					if(certainties.find(feature)==certainties.end()){
+						key[i] = feature;
+						lattice.insert(std::make_pair(key,(DecisionTreeNode<T>*)NULL));
+					};
+				};
+			};
+			for(itr = certainties.begin();itr!=certainties.end();itr++){
+				/*Create a feature for every feature associated with a condition*/
+				DecisionTreeNode<T>* new_node = NULL;
+				if(options.share_permutations){
+					/*Every order of the same features leads to the same counts and the same subtree,
+					 * so the node that was built for this set of features is shared.*/
+					std::vector<int> key = lattice_key(conditions_found,features_path);
+					key[i] = itr->first;
+					std::lock_guard<std::mutex> guard(lattice_lock);
+					DecisionTreeNode<T>*& shared = lattice[key];
+					if(shared){
+						p->children.push_back(shared_node(key,i,added));
+						continue;
+					};
+					shared = new_node = make_node(i, itr->first,itr->second);
+				}
+				else{
+					new_node = make_node(i, itr->first,itr->second);
+				};
+				added++;
+				p->children.push_back(new_node);
+				//add new node to current node's children
+				new_node->parent =p;
+				//assign parent
+				bool make_leaf = false;
+				typename std::map<int,float>::iterator prune_checker;
+				for(prune_checker =itr->second.begin();prune_checker!=itr->second.end();
+						prune_checker++){
+					/*If the node has an outcome with a certainty >= "prune_certainty",
+					 * we can make the new node a leaf.*/
+					if(prune_checker->second >= prune_certainty){
+						make_leaf = true;
+						break;
+					};
+					
+				};
+				std::vector<int> features_path_copy = features_path;
+				features_path_copy.push_back(itr->first);
+				//copy the new feature to the features on the path
+				if(options.lazy){
+				/*The subtree is left to be built when a query reaches the node.*/
+				new_node->expanded = make_leaf;
+				}
+				else if(!make_leaf && pool &&
+						table.num_conditions()-conditions_found_copy.size() > options.serial_cutoff){
+				/*A subtree that is large enough is handed to the pool. It shares nothing with the
+				 * rest of the tree but the read-only table, and the children of "p" are already in
+				 * order, so the tree comes out the same as a serial build.*/
+				std::vector<int> child_rows;
+				if(!feature_rows.empty()){
+					child_rows.swap(feature_rows[itr->first]);
+				};
+				pool->submit([this,new_node,conditions_found_copy,features_path_copy,
+						root_condition_index,child_rows](){
+					size_ += build_decision_tree(new_node,conditions_found_copy,features_path_copy,
+							root_condition_index,child_rows);
+				});
+				}
+				else if(!make_leaf){
+				/*If the node is a leaf, then there is no need to continue adding to the path.*/
+				added += build_decision_tree(new_node, conditions_found_copy,features_path_copy,
+						root_condition_index,
+						feature_rows.empty() ? rows : feature_rows[itr->first]);
+				//Continue building with the node just created, thereby doing a depth-first build
+				};
+			};
+			};
+		};
+	};
+	return added;
+}	
+
+template<class T>
+DecisionTree<T>::DecisionTree(const std::vector<T>& conditions, const std::vector<std::vector<T> >& data,
+	       	int root_condition_index,int min_occur, float prune, const TreeOptions& opts)
+		:own_table(sorted_table(EncodedTable<T>(conditions,data))),shared_table(own_table),table(*shared_table),options(opts){
+	/* The constructor encodes the data table and then builds the tree on the codes.*/
+	init(root_condition_index,min_occur,prune);
+}
+
+template<class T>
+DecisionTree<T>::DecisionTree(const EncodedTable<T>& data, int root_condition_index,int min_occur, float prune,
+		const TreeOptions& opts):own_table(sorted_table(data)),shared_table(own_table),table(*shared_table),options(opts){
+	/* A table that was encoded ahead of time (for instance by a loader) is copied as is.*/
+	init(root_condition_index,min_occur,prune);
+}
+
+template<class T>
+DecisionTree<T>::DecisionTree(const std::shared_ptr<const EncodedTable<T> >& data,
+		const std::shared_ptr<const BitmapIndex>& idx, const std::shared_ptr<const ContingencyCube>& cb,
+		const std::shared_ptr<CountCache>& counts, int root_condition_index, int min_occur, float prune,
+		const TreeOptions& opts)
+		:shared_table(data),table(*shared_table),options(opts),index(idx),cube(cb),count_cache(counts){
+	/* The table of a forest is already sorted, and its index or cube is only built once for every tree.*/
+	init(root_condition_index,min_occur,prune);
+}
+
+template<class T>
+std::shared_ptr<EncodedTable<T> > DecisionTree<T>::sorted_table(EncodedTable<T> data){
+	//the table is the tree's own, as "add_rows" and "remove_rows" change it later
+	data.sort_symbols();
+	return std::make_shared<EncodedTable<T> >(std::move(data));
+}
+
+template<class T>
+void DecisionTree<T>::init(int root_condition_index,int min_occur, float prune){
+	/* The constructor allocated memory for the root, which serves as a dummy. Each decision tree starts 
+	 * at one of the condition specified and builds from there, where the "root condition" technically serves
+	 * as the root of the tree even though it does not technically offer any information about the outcome alone.
+	 * This simply allows us to build from a certain condition to look for optimal trees. Note that the codes
+	 * were sorted by the constructor so that the children of every node come in the order of their features.*/
+	if(options.counting==BITMAP_INDEX && !index){
+		index.reset(new BitmapIndex(table));
+	};
+	if(options.counting==CONTINGENCY_CUBE && !cube){
+		cube.reset(new ContingencyCube(table));
+	};
+	prune_certainty=prune;
+	min_occurences = min_occur;
+	//dummy_root
+	std::vector<int> conditions_found;
+	std::vector<int> features_path;
+	std::vector<int> rows;
+	if(options.counting==ROW_SUBSETS){
+		//every row matches the empty path at the root
+		for(int i=0;i<table.rows();i++){
+			rows.push_back(i);
+		};
+	};
+	std::pmr::memory_resource* upstream = options.memory ? options.memory : std::pmr::new_delete_resource();
+	if(options.threads>1 && options.memory){
+		locked_memory.reset(new LockedResource(options.memory));
+		upstream = locked_memory.get();
+	};
+	for(int i=0;i<=(options.threads>1 ? options.threads : 0);i++){
+		arenas.push_back(std::unique_ptr<std::pmr::monotonic_buffer_resource>(
+					new std::pmr::monotonic_buffer_resource(1<<16,upstream)));
+		if(options.threads>1 && !options.lazy){
+			locked_arenas.push_back(std::unique_ptr<LockedResource>(new LockedResource(arenas.back().get())));
+		};
+	};
+	root = make_node(root_condition_index);
+	//dummy_root node with starting condition
+	size_=1;
+	if(options.lazy){
+		//nothing but the root is built until the tree is first queried
+		options.share_permutations = false;
+		root->expanded = false;
+		return;
+	};
+	if(options.threads>1){
+		pool.reset(new WorkStealingPool(options.threads));
+	};
+	size_ += this->build_decision_tree(root,conditions_found, features_path,root_condition_index,rows);
+	if(pool){
+		//wait for every subtree handed to the pool before the workers are let go
+		pool->wait();
+		pool.reset();
+	};
+	if(options.share_permutations){
+		link_lattice_aliases();
+	};
+	bound_subtree(root);
+
+}
+
+
+template<class T> void DecisionTree<T>::print_sideways(std::ostream& ostr) const {
+    //DRIVER FOR PRINT_SIDEWAYS
+    if(this->size_==0){
+    	ostr << "Tree is empty.\n";
+	return;
+    };
+    expand_all(this->root);
+    print_sideways(ostr, this->root, 0);
+}
+
+template <class T> void DecisionTree<T>::print_all_paths(std::ostream& ostr, DecisionTreeNode<T>* p,
+		std::vector<DecisionTreeNode<T>*>& path)const{
+/* This recursive function prints all the paths in the tree using a depth-first search. The path is a
+ * stack that every child is pushed onto and popped off again, so no path is ever copied.*/
+if(p->children.size()==0){
+//Base case: if leaf is found, just print the accumulated path
+ostr << "General Outcomes for path:";
+	for(int i = 1;i<path.size();i++){
+		ostr << ' ' << item_name(path[i]);
+	};
+	ostr << std::endl;
+	typename std::map<int,float>::const_iterator itr;
+	for(itr = p->outcome_certainties.begin();itr!=p->outcome_certainties.end();itr++){
+		ostr << "   "<< table.decode(table.outcome_column(),itr->first) << ' ' << itr->second << std::endl;
+	};
+
+};
+for(int i=0;i<p->children.size();i++){
+	/*Continue searching down each of the children.*/
+	path.push_back(p->children[i]);
+	print_all_paths(ostr, p->children[i], path);
+	path.pop_back();
+};
+}
+
+	
+template <class T> void DecisionTree<T>::print_all_paths(std::ostream& ostr)const{
+//DRIVER FOR PRINT_ALL_PATHS
+std::vector<DecisionTreeNode<T>*> path;
+path.push_back(root);
+expand_all(root);
+this->print_all_paths(ostr,root,path);
+}
+
+
+
+template <class T>
+void DecisionTree<T>::get_best_paths(const QueryMask& query, PathSearch<DecisionTreeNode<T>*>& search,
+			DecisionTreeNode<T>* p)const{
+	/*This recursive function is a utility for the "print_best_paths_for_query" function. Using a depth-first
+	 * search, for those paths that match the query in whatever order, even if a truncated version of the path
+	 * the query suggests, the certainty of the outcome of that path is evaluated. The highest certainty and 
+	 * its outcome is appropriately tracked (see PathSearch, whose path is the path to "p").*/
+if(!p){
+	return;
+};
+expand(p);
+if(p->children.size()==0){
+	//BASE CASE
+	/* If a path that adheres to the query has reached a leaf, then evaluate its certainty and outcomes.*/
+	typename std::map<int,float>::const_iterator itr;
+	float max_certainty = 0;
+	int certainty_elem = -1;
+	for(itr = p->outcome_certainties.begin();itr!=p->outcome_certainties.end();itr++){
+		//Find max certainty of outcomes at this node
+		if(itr->second > max_certainty){
+			certainty_elem = itr->first;
+			max_certainty = itr->second;	
+		};
+	};
+	/*If equal, then can add path to best paths, and if higher, the path replaces them*/
+	search.weigh(search.path,max_certainty,certainty_elem);
+};
+//only continue searching path if next entry is in query as well
+query.for_each_match(p->children.size(),
+		[p](int i){return std::make_pair(p->children[i]->parent_condition,p->children[i]->item);},
+		[&](int i){
+	if(p->children[i]->max_certainty < search.best_certainty){
+		//no leaf below the child can tie the best paths found so far
+		return;
+	};
+	search.path.push_back(p->children[i]);
+	get_best_paths(query, search, p->children[i]);
+	search.path.pop_back();
+});
+}
+
+
+
+template <class T>
+QueryResult<T> DecisionTree<T>::query(const std::vector<T>& query)const{
+	/*This function finds the paths that lead to the most "certain" outcome for a 
+	 * certain query. Note that it will keep only those paths with the highest
+	 * certainty, so unless there is a tie for the highest certainty among several
+	 * paths, it will find only one path.*/
+	/*The encoded query, its mask and the search are kept from one query to the next (one of each per
+	 * thread, as several threads may query at once), so once they have grown, only the result that is
+	 * handed back allocates.*/
+	static thread_local std::vector<std::vector<int> > encoded;
+	static thread_local QueryMask mask;
+	static thread_local PathSearch<DecisionTreeNode<T>*> search;
+	table.encode_query(query,encoded);
+	mask.compile(encoded);
+	search.reset(root);
+	//Pass "search" in as reference to recursive utility
+	this->get_best_paths(mask,search,root);
+	return make_result(search);
+}
+
+template <class T>
+std::vector<QueryResult<T> > DecisionTree<T>::query_all(const std::vector<std::vector<T> >& queries)const{
+	/*The queries are answered together, as a trie of the queries laid over the tree: every node is visited
+	 * once, for the queries whose features its path follows, so the paths that several queries share
+	 * are only searched once and the nodes that no query follows are never visited. Queries with the
+	 * same features (in any order) are only answered once.*/
+	std::vector<std::vector<std::vector<int> > > distinct;
+	std::map<std::vector<std::vector<int> >,int> distinct_index;
+	std::vector<int> query_of(queries.size());
+	for(int i=0;i<queries.size();i++){
+		std::vector<std::vector<int> > encoded = table.encode_query(queries[i]);
+		for(int j=0;j<encoded.size();j++){
+			std::sort(encoded[j].begin(),encoded[j].end());
+			encoded[j].erase(std::unique(encoded[j].begin(),encoded[j].end()),encoded[j].end());
+		};
+		std::map<std::vector<std::vector<int> >,int>::iterator found = distinct_index.find(encoded);
+		if(found==distinct_index.end()){
+			found = distinct_index.insert(std::make_pair(encoded,(int)distinct.size())).first;
+			distinct.push_back(encoded);
+		};
+		query_of[i] = found->second;
+	};
+	std::vector<int> active;
+	for(int i=0;i<distinct.size();i++){
+		active.push_back(i);
+	};
+	std::vector<PathSearch<DecisionTreeNode<T>*> > searches(distinct.size());
+	std::vector<DecisionTreeNode<T>*> current_path;
+	current_path.push_back(root);
+	std::vector<QueryMask> masks;
+	for(int i=0;i<distinct.size();i++){
+		masks.push_back(QueryMask(distinct[i]));
+	};
+	if(!active.empty()){
+		get_best_paths(masks,active,0,current_path,searches,root);
+	};
+	std::vector<QueryResult<T> > results;
+	for(int i=0;i<distinct.size();i++){
+		results.push_back(make_result(searches[i]));
+	};
+	std::vector<QueryResult<T> > ret;
+	for(int i=0;i<queries.size();i++){
+		ret.push_back(results[query_of[i]]);
+	};
+	return ret;
+}
+
+template <class T>
+void DecisionTree<T>::get_best_paths(const std::vector<QueryMask>& queries,
+			std::vector<int>& active, int first_active, std::vector<DecisionTreeNode<T>*>& current_path,
+			std::vector<PathSearch<DecisionTreeNode<T>*> >& searches, DecisionTreeNode<T>* p)const{
+	/*This is the search of "get_best_paths" for every active query at once. The queries that the feature of
+	 * a child is in go down to the child together, and a leaf is weighed once for all of them, so every
+	 * query finds the same paths, in the same order, as it would on its own. The queries of a child are
+	 * pushed onto the end of "active" and taken off again once the child is searched, like the path.*/
+	int last_active = active.size();
+	expand(p);
+	if(p->children.size()==0){
+		typename std::pmr::map<int,float>::const_iterator itr;
+		float max_certainty = 0;
+		int certainty_elem = -1;
+		for(itr = p->outcome_certainties.begin();itr!=p->outcome_certainties.end();itr++){
+			if(itr->second > max_certainty){
+				certainty_elem = itr->first;
+				max_certainty = itr->second;
+			};
+		};
+		for(int k=first_active;k<last_active;k++){
+			searches[active[k]].weigh(current_path,max_certainty,certainty_elem);
+		};
+	};
+	for(int i=0;i<p->children.size();i++){
+		for(int k=first_active;k<last_active;k++){
+			if(queries[active[k]].has(p->children[i]->parent_condition,p->children[i]->item) &&
+					p->children[i]->max_certainty >= searches[active[k]].best_certainty){
+				active.push_back(active[k]);
+			};
+		};
+		if(active.size()>last_active){
+			current_path.push_back(p->children[i]);
+			get_best_paths(queries,active,last_active,current_path,searches,p->children[i]);
+			current_path.pop_back();
+			active.resize(last_active);
+		};
+	};
+}
+
+template <class T>
+QueryResult<T> DecisionTree<T>::make_result(PathSearch<DecisionTreeNode<T>*>& search)const{
+	/*The paths are only copied out of the search here, once the search is over, each straight into its
+	 * place in the result, so the result is all that is allocated.*/
+	QueryResult<T> result;
+	result.root_condition_index = root->parent_condition;
+	result.root_condition = item_name(root);
+	const std::vector<int>& outcomes = search.outcomes;
+	if(search.num_paths()==0){
+		/*If no paths beat the best_certainty of -1, then no paths matched the query as a path has 
+		 at least a certainty of 0.*/
+		return result;
+	};
+	result.matched = true;
+	result.certainty = search.best_certainty;
+	//need to keep only unique paths (every path keeps its own outcome)
+	const std::vector<int>& final_best_paths = search.distinct_paths(
+			[](const DecisionTreeNode<T>* n){return std::make_pair(n->parent_condition,n->item);});
+	//Decode the paths with the associated outcome
+	result.paths.resize(final_best_paths.size());
+	for(int i=0;i<final_best_paths.size();i++){
+		QueryPath<T>& path = result.paths[i];
+		int k = final_best_paths[i];
+		if(outcomes[k]>=0){
+			//a root without children has no outcome of its own
+			path.outcome = table.decode(table.outcome_column(),outcomes[k]);
+		};
+		path.features.reserve(search.path_end(k)-search.path_begin(k)-1);
+		for(int j=search.path_begin(k)+1;j<search.path_end(k);j++){
+			const DecisionTreeNode<T>* n = search.best_nodes[j];
+			path.features.push_back(std::make_pair(table.condition(n->parent_condition),item_name(n)));
+		};
+	};
+	return result;
+}
+
+template <class T>
+void print_query_result(const QueryResult<T>& result){
+	/*Prints what "query" found as "print_best_paths_for_query" always has.*/
+	if(!result.matched){
+		std::cerr << "No outcomes matched the conditions in the input query." << std::endl;
+		exit(1);
+	};
+	std::cout << "For best_certainty of " << std::setprecision(3)
+	       	<< (float)result.certainty << " with root_condition of " <<
+		result.root_condition << std::endl;
+	//Print the paths with the associated outcome and its certainty
+	for(int i=0;i<result.paths.size();i++){
+		std::cout << "Outcome of " << result.paths[i].outcome
+			<< " with the following features:\n";
+		for(int j=0;j<result.paths[i].features.size();j++){
+			std::cout << "   Condition " << result.paths[i].features[j].first
+			       << ": " << result.paths[i].features[j].second << std::endl;
+		};
+		std::cout << std::endl;
+	};
+}
+
+template <class T>
+void DecisionTree<T>::print_best_paths_for_query(const std::vector<T>& query)const{
+	/*This function prints the paths that lead to the most "certain" outcome for a 
+	 * certain query (see "query").*/
+	print_query_result(this->query(query));
+}
+
+
+template<class T> void DecisionTree<T>::print_sideways
+(std::ostream& ostr,DecisionTreeNode<T>* p, int depth) const {
+   /* The print_sideways function prints the tree to a stream and 
+    * represents the structure of the tree along with all the keys 
+    * associated with each node. It is accomplished using an in-order
+    * traversal of each node.*/
+    if(!p->children.size()==0){ 
+	    //Left 
+    for(int i=0;i<p->children.size()/2;i++){
+	      print_sideways(ostr, p->children[i], depth+1);	      
+    };
+    //Root
+    ostr << std::string(depth,'\t');
+	ostr<<item_name(p);
+    ostr << std::endl;
+    //Right
+    if(!p->children.size()==0){
+    for(int i=p->children.size()/2;i<p->children.size();i++){
+	      print_sideways(ostr, p->children[i], depth+1);	      
+    };
+    };
+   };
+
+}
+
+template <class T>
+std::vector<int> DecisionTree<T>::lattice_key(const std::vector<int>& conditions_found,
+		const std::vector<int>& features_path)const{
+	std::vector<int> key(table.num_conditions(),-1);
+	for(int j=0;j<features_path.size();j++){
+		key[conditions_found[j]] = features_path[j];
+	};
+	return key;
+}
+
+template <class T>
+bool DecisionTree<T>::link_shared_children(DecisionTreeNode<T>* p, const std::vector<int>& conditions_found,
+		const std::vector<int>& features_path, int condition){
+	/*If the set of features on the path plus each feature of the condition has been counted before,
+	 * the nodes are linked below "p" in the order of the features and nothing has to be counted.*/
+	std::vector<int> key = lattice_key(conditions_found,features_path);
+	std::lock_guard<std::mutex> guard(lattice_lock);
+	for(int feature=0;feature<table.symbols(condition).size();feature++){
+		key[condition] = feature;
+		if(lattice.find(key)==lattice.end()){
+			return false;
+		};
+	};
+	int added = 0;
+	for(int feature=0;feature<table.symbols(condition).size();feature++){
+		key[condition] = feature;
+		if(lattice[key]){
+			p->children.push_back(shared_node(key,condition,added));
+		};
+	};
+	size_ += added;
+	return true;
+}
+
+template <class T>
+DecisionTreeNode<T>* DecisionTree<T>::shared_node(const std::vector<int>& key, int condition, int& added){
+	/*The node of the set can be shared as is when its path ended with the same condition. Otherwise
+	 * the path prints a different feature last, so it goes through an alias of the node that has the
+	 * same outcomes and (once the build is done) the same children. Note that "lattice_lock" is held.*/
+	DecisionTreeNode<T>* node = lattice[key];
+	if(node->parent_condition==condition){
+		return node;
+	};
+	std::vector<int> alias_key = key;
+	alias_key.push_back(condition);
+	DecisionTreeNode<T>*& alias = lattice_aliases[alias_key];
+	if(!alias){
+		alias = make_node(condition, key[condition],
+				std::map<int,float>(node->outcome_certainties.begin(),node->outcome_certainties.end()));
+		added++;
+	};
+	return alias;
+}
+
+template <class T>
+void DecisionTree<T>::link_lattice_aliases(){
+	/*An alias stands for the same set of features as the node in "lattice", so its children are the
+	 * same nodes. Their own children are linked through the nodes themselves.*/
+	typename std::map<std::vector<int>,DecisionTreeNode<T>*>::iterator itr;
+	for(itr=lattice_aliases.begin();itr!=lattice_aliases.end();itr++){
+		std::vector<int> key(itr->first.begin(),itr->first.end()-1);
+		itr->second->children = lattice[key]->children;
+	};
+}
+
+template <class T>
+std::pmr::memory_resource* DecisionTree<T>::arena()const{
+	//workers are numbered from 0 and the constructing thread (-1) takes the first arena
+	int id = pool ? pool->current_worker()+1 : 0;
+	if(!locked_arenas.empty()){
+		return locked_arenas[id].get();
+	};
+	return arenas[id].get();
+}
+
+template <class T>
+template <class... Args>
+DecisionTreeNode<T>* DecisionTree<T>::make_node(Args... args){
+	std::pmr::memory_resource* resource = arena();
+	void* memory = resource->allocate(sizeof(DecisionTreeNode<T>),alignof(DecisionTreeNode<T>));
+	return new (memory) DecisionTreeNode<T>(args...,resource);
+}
+
+template <class T>
+void DecisionTree<T>::expand(DecisionTreeNode<T>* p)const{
+	/*The children of a node are built exactly as the constructor would have built them, only one level
+	 * at a time: the path to the node is read back from its parents, and the children that are not leaves
+	 * are left to be expanded in turn. Expanding a node only adds to the tree and never changes what a
+	 * query finds, so a query stays const even though it may build the nodes it reaches.*/
+	if(!options.lazy){
+		return;
+	};
+	std::lock_guard<std::mutex> guard(expand_lock);
+	if(p->expanded){
+		return;
+	};
+	DecisionTree<T>* self = const_cast<DecisionTree<T>*>(this);
+	std::vector<int> conditions_found;
+	std::vector<int> features_path;
+	for(const DecisionTreeNode<T>* n=p;n->parent;n=n->parent){
+		conditions_found.insert(conditions_found.begin(),n->parent_condition);
+		features_path.insert(features_path.begin(),n->item);
+	};
+	std::vector<int> rows;
+	if(options.counting==ROW_SUBSETS){
+		//the rows of the path are not kept between expansions, so they are found again
+		rows = rows_of_path(conditions_found,features_path);
+	};
+	self->size_ += self->build_decision_tree(p,conditions_found,features_path,root->parent_condition,rows);
+	//"p" keeps its bound of 1, as a query may be reading it, so only the new children are bounded
+	for(int i=0;i<p->children.size();i++){
+		bound_subtree(p->children[i]);
+	};
+	p->expanded = true;
+}
+
+template <class T>
+void DecisionTree<T>::expand_all(DecisionTreeNode<T>* p)const{
+	//Used before the whole tree is printed or frozen
+	if(!options.lazy){
+		return;
+	};
+	expand(p);
+	for(int i=0;i<p->children.size();i++){
+		expand_all(p->children[i]);
+	};
+}
+
+template <class T>
+float DecisionTree<T>::bound_subtree(DecisionTreeNode<T>* p)const{
+	/*The bound of a leaf is the certainty of its most certain outcome, and the bound of any other node is
+	 * the highest bound of its children, so a query can pass over a child whose bound is below the best
+	 * certainty it has already found (see "get_best_paths"). A node whose children are not built yet could
+	 * have any leaf below it, so its bound is 1. A node that already has a bound is not walked again, which
+	 * keeps the nodes a lattice shares from being walked once for every path to them.*/
+	if(p->max_certainty>=0){
+		return p->max_certainty;
+	};
+	float bound = 0;
+	if(!p->expanded){
+		bound = 1;
+	}
+	else if(p->children.size()==0){
+		typename std::pmr::map<int,float>::const_iterator itr;
+		for(itr=p->outcome_certainties.begin();itr!=p->outcome_certainties.end();itr++){
+			bound = std::max(bound,itr->second);
+		};
+	}
+	else{
+		for(int i=0;i<p->children.size();i++){
+			bound = std::max(bound,bound_subtree(p->children[i]));
+		};
+	};
+	p->max_certainty = bound;
+	return bound;
+}
+
+template <class T>
+std::vector<int> DecisionTree<T>::rows_of_path(const std::vector<int>& conditions_found,
+		const std::vector<int>& features_path)const{
+	std::vector<int> rows;
+	for(int i=0;i<table.rows();i++){
+		bool candidate = true;
+		for(int j=0;j<features_path.size() && candidate;j++){
+			candidate = table.at(i,conditions_found[j])==features_path[j];
+		};
+		if(candidate){
+			rows.push_back(i);
+		};
+	};
+	return rows;
+}
+
+template <class T>
+void DecisionTree<T>::add_rows(const std::vector<std::vector<T> >& rows){
+	/*The rows are appended to the tree's own copy of the table (only a DecisionForest shares its table,
+	 * and its trees cannot be changed). A feature that was never seen before is given a new code, so the
+	 * codes are then sorted again (see "update").*/
+	EncodedTable<T>& data = *own_table;
+	std::vector<int> changed;
+	bool new_features = false;
+	std::vector<int> codes(data.width());
+	for(int i=0;i<rows.size();i++){
+		for(int c=0;c<data.width() && !new_features;c++){
+			new_features = data.symbols(c).lookup(rows[i][c])<0;
+		};
+		changed.push_back(data.rows());
+		data.add_row(rows[i]);
+		if(!rows_of_codes.empty() && !new_features){
+			for(int c=0;c<data.width();c++){
+				codes[c] = data.at(changed.back(),c);
+			};
+			rows_of_codes[codes].push_back(changed.back());
+		};
+	};
+	update(changed,new_features);
+}
+
+template <class T>
+int DecisionTree<T>::remove_rows(const std::vector<std::vector<T> >& rows){
+	/*A row is taken out by lowering the weight of a row of the table with the same codes, so the codes
+	 * never change. A row with no weight left stays in the table, where it counts for nothing. The rows
+	 * with the same codes are looked up in "rows_of_codes", so taking a row out does not scan the table.*/
+	EncodedTable<T>& data = *own_table;
+	std::vector<int> codes(data.width());
+	if(rows_of_codes.empty()){
+		for(int r=0;r<data.rows();r++){
+			for(int c=0;c<data.width();c++){
+				codes[c] = data.at(r,c);
+			};
+			rows_of_codes[codes].push_back(r);
+		};
+	};
+	std::vector<int> changed;
+	for(int i=0;i<rows.size();i++){
+		bool known = true;
+		for(int c=0;c<data.width() && known;c++){
+			codes[c] = data.symbols(c).lookup(rows[i][c]);
+			known = codes[c]>=0;
+		};
+		typename std::map<std::vector<int>, std::vector<int> >::iterator itr = rows_of_codes.find(codes);
+		if(!known || itr==rows_of_codes.end()){
+			continue;
+		};
+		for(int k=0;k<itr->second.size();k++){
+			int r = itr->second[k];
+			if(data.weight(r)>0){
+				data.add_weight(r,-1);
+				changed.push_back(r);
+				break;
+			};
+		};
+	};
+	update(changed,false);
+	return changed.size();
+}
+
+template <class T>
+void DecisionTree<T>::update(const std::vector<int>& changed, bool new_features){
+	/*Only the counts of the paths that a changed row matches can change, so only those nodes are looked
+	 * at (see "update_node"). The index or cube of the table is made again. New features are put into
+	 * the order of the other codes by sorting the table again, which renumbers the nodes of the columns
+	 * that gained a feature. A lattice shares its nodes between the orders of a path, so it is simply
+	 * built again. The nodes that are taken out keep their memory in the arenas until the tree goes.*/
+	if(changed.empty()){
+		return;
+	};
+	EncodedTable<T>& data = *own_table;
+	if(new_features){
+		//the codes are about to change, so the rows are looked up again by the next "remove_rows"
+		rows_of_codes.clear();
+		std::vector<std::vector<T> > symbols(data.width());
+		for(int c=0;c<data.width();c++){
+			for(int code=0;code<data.symbols(c).size();code++){
+				symbols[c].push_back(data.decode(c,code));
+			};
+		};
+		data.sort_symbols();
+		std::vector<std::vector<int> > remap(data.width());
+		for(int c=0;c<data.width();c++){
+			for(int code=0;code<symbols[c].size();code++){
+				remap[c].push_back(data.symbols(c).lookup(symbols[c][code]));
+			};
+		};
+		if(!options.share_permutations){
+			remap_codes(root,remap);
+		};
+	};
+	if(index){
+		index.reset(new BitmapIndex(table));
+	};
+	if(cube){
+		cube.reset(new ContingencyCube(table));
+	};
+	if(options.share_permutations){
+		rebuild();
+		return;
+	};
+	std::lock_guard<std::mutex> guard(expand_lock);
+	std::vector<int> rows;
+	if(options.counting==ROW_SUBSETS){
+		rows = rows_of_path(std::vector<int>(),std::vector<int>());
+	};
+	if(root->expanded){
+		update_node(root,std::vector<int>(),std::vector<int>(),rows,changed);
+	};
+}
+
+template <class T>
+void DecisionTree<T>::update_node(DecisionTreeNode<T>* p, const std::vector<int>& conditions_found,
+		const std::vector<int>& features_path, const std::vector<int>& rows, const std::vector<int>& changed){
+	/*The children of "p" are the features of the conditions off the path that clear "min_occurences",
+	 * and the changed rows only change the counts of their own features. For each of those, the child is
+	 * taken out if it no longer clears "min_occurences", made if it now does, and otherwise given its new
+	 * certainties. A child that turns into a leaf loses its subtree, a leaf that no longer is one has its
+	 * subtree built (or left to be built, in the lazy mode), and any other child is updated in turn with
+	 * the changed rows of its feature. The tree comes out as if it had been built on the table as it is.*/
+	int root_condition_index = root->parent_condition;
+	for(int i=0;i<table.num_conditions();i++){
+		if(std::find(conditions_found.begin(),conditions_found.end(),i)!=conditions_found.end() ||
+				(conditions_found.size()==0 && i!=root_condition_index)){
+			continue;
+		};
+		std::vector<int> conditions_found_copy = conditions_found;
+		conditions_found_copy.push_back(i);
+		std::vector<std::vector<int> > feature_rows;
+		std::map<int,std::map<int,float> > certainties = get_certainties(features_path,
+				conditions_found_copy,rows,feature_rows);
+		std::map<int,std::vector<int> > changed_of_feature;
+		for(int r=0;r<changed.size();r++){
+			changed_of_feature[table.at(changed[r],i)].push_back(changed[r]);
+		};
+		typename std::map<int,std::vector<int> >::iterator itr;
+		for(itr=changed_of_feature.begin();itr!=changed_of_feature.end();itr++){
+			int feature = itr->first;
+			//the children are in the order of their conditions and then of their features
+			int position = 0;
+			while(position<p->children.size() && (p->children[position]->parent_condition<i ||
+					(p->children[position]->parent_condition==i && p->children[position]->item<feature))){
+				position++;
+			};
+			DecisionTreeNode<T>* child = NULL;
+			if(position<p->children.size() && p->children[position]->parent_condition==i &&
+					p->children[position]->item==feature){
+				child = p->children[position];
+			};
+			typename std::map<int,std::map<int,float> >::iterator counted = certainties.find(feature);
+			if(counted==certainties.end()){
+				if(child){
+					size_ -= subtree_size(child);
+					p->children.erase(p->children.begin()+position);
+				};
+				continue;
+			};
+			bool make_leaf = false;
+			bool was_leaf = !child;
+			typename std::map<int,float>::iterator prune_checker;
+			for(prune_checker=counted->second.begin();prune_checker!=counted->second.end();prune_checker++){
+				make_leaf = make_leaf || prune_checker->second >= prune_certainty;
+			};
+			if(child){
+				typename std::pmr::map<int,float>::iterator old_checker;
+				for(old_checker=child->outcome_certainties.begin();
+						old_checker!=child->outcome_certainties.end();old_checker++){
+					was_leaf = was_leaf || old_checker->second >= prune_certainty;
+				};
+				child->outcome_certainties.clear();
+				child->outcome_certainties.insert(counted->second.begin(),counted->second.end());
+			}
+			else{
+				child = make_node(i,feature,counted->second);
+				child->parent = p;
+				p->children.insert(p->children.begin()+position,child);
+				size_++;
+			};
+			std::vector<int> features_path_copy = features_path;
+			features_path_copy.push_back(feature);
+			//the bound of the child is worked out again once its subtree is up to date
+			child->max_certainty = -1;
+			if(make_leaf){
+				size_ -= subtree_size(child)-1;
+				child->children.clear();
+				child->expanded = true;
+			}
+			else if(was_leaf){
+				//the subtree is built as the constructor would build it (a lazy tree leaves it for later)
+				child->expanded = !options.lazy;
+				if(!options.lazy){
+					size_ += build_decision_tree(child,conditions_found_copy,features_path_copy,
+							root_condition_index,feature_rows.empty() ? rows : feature_rows[feature]);
+				};
+			}
+			else if(child->expanded){
+				update_node(child,conditions_found_copy,features_path_copy,
+						feature_rows.empty() ? rows : feature_rows[feature],itr->second);
+			};
+		};
+	};
+	p->max_certainty = -1;
+	bound_subtree(p);
+}
+
+template <class T>
+int DecisionTree<T>::subtree_size(const DecisionTreeNode<T>* p)const{
+	int size = 1;
+	for(int i=0;i<p->children.size();i++){
+		size += subtree_size(p->children[i]);
+	};
+	return size;
+}
+
+template <class T>
+void DecisionTree<T>::remap_codes(DecisionTreeNode<T>* p, const std::vector<std::vector<int> >& remap){
+	//the features that were already there keep their order, so the children stay in order
+	if(p->item>=0){
+		p->item = remap[p->parent_condition][p->item];
+	};
+	std::map<int,float> certainties(p->outcome_certainties.begin(),p->outcome_certainties.end());
+	p->outcome_certainties.clear();
+	typename std::map<int,float>::iterator itr;
+	for(itr=certainties.begin();itr!=certainties.end();itr++){
+		p->outcome_certainties[remap[table.outcome_column()][itr->first]] = itr->second;
+	};
+	for(int i=0;i<p->children.size();i++){
+		remap_codes(p->children[i],remap);
+	};
+}
+
+template <class T>
+void DecisionTree<T>::rebuild(){
+	int root_condition_index = root->parent_condition;
+	for(int i=0;i<arenas.size();i++){
+		arenas[i]->release();
+	};
+	locked_arenas.clear();
+	arenas.clear();
+	lattice.clear();
+	lattice_aliases.clear();
+	init(root_condition_index,min_occurences,prune_certainty);
+}
+
+template <class T>
+DecisionTree<T>::~DecisionTree(){
+	/*Every node, child list and outcome map lives in the arenas, and nothing in them needs its
+	 * destructor run, so the whole tree (lattice or not) is freed by releasing the arenas instead of
+	 * walking and deleting every node.*/
+	for(int i=0;i<arenas.size();i++){
+		arenas[i]->release();
+	};
+}
+
+
+template <class T>
+class FrozenDecisionTree{
+	/* This class is a read-only copy of a finished DecisionTree that is laid out for queries. Rather
+	 * than nodes scattered through the heap that point to their children, every node is an entry in
+	 * one contiguous array in breadth-first order, so the children of a node are a range of indices,
+	 * and the certainty of every outcome is kept in a small fixed-size array per node (one slot per
+	 * outcome, 0 where an outcome never occured) instead of a map. Queries and printing give the same
+	 * results as the DecisionTree the copy was made from, which can be destroyed once it is frozen.*/
+	private:
+	struct FrozenNode{
+		int item;
+		//The code of the feature of the node (-1 for the root)
+		int condition;
+		//The index of the condition to which the feature refers
+		int first_child;
+		//Where the children of the node start in "child_index"
+		int num_children;
+		//How many children the node has
+		float max_certainty;
+		//The highest certainty of any leaf below the node (as in DecisionTreeNode)
+	};
+	//MEMBER VARIABLES
+	std::vector<FrozenNode> nodes;
+	//Every node in breadth-first order (the root is node 0)
+	std::vector<int> child_index;
+	/*The children of every node, one range per node. For a tree, a range is simply the next nodes in
+	 * breadth-first order, but a lattice (see "share_permutations") can share a child between ranges.*/
+	std::vector<float> certainties;
+	//The certainty of every outcome of every node, "num_outcomes" slots per node
+	int num_outcomes;
+	//The number of outcomes in the table
+	EncodedTable<T> schema;
+	//The names and symbol tables of the table the tree was built on (for encoding and printing)
+
+	//UTILITIES
+	const T& item_name(int n)const;
+	//Decodes the feature of a node (the root is named after its condition)
+	void get_best_paths(const QueryMask& query, PathSearch<int>& search, int n)const;
+	//A recursive utility "print_best_paths_for_query"'s public option
+	void print_all_paths(std::ostream& ostr, int n, std::vector<int>& path)const;
+	//A recursive utility "print_all_paths"'s public option
+
+	public:
+	//CONSTRUCTORS
+	FrozenDecisionTree(const EncodedTable<T>& table, const DecisionTreeNode<T>* root);
+	//ACCESSORS
+	int get_size()const{return nodes.size();}
+	//PUBLIC UTILITIES
+	QueryResult<T> query(const std::vector<T>& query)const;
+	//Finds the paths that generate the highest degree of certainty without printing them
+	void print_best_paths_for_query(const std::vector<T>& query)const;
+	//Prints the paths that generate the highest degree of certainty
+	void print_all_paths(std::ostream& ostr)const;
+	//A utility print all the paths in the tree from the root
+};
+
+template <class T>
+FrozenDecisionTree<T> DecisionTree<T>::freeze()const{
+	expand_all(root);
+	return FrozenDecisionTree<T>(table,root);
+}
+
+template <class T>
+FrozenDecisionTree<T>::FrozenDecisionTree(const EncodedTable<T>& table, const DecisionTreeNode<T>* root)
+		:schema(table.schema()){
+	/*The nodes are numbered in breadth-first order first, which keeps the children of every node of a
+	 * tree next to one another, and then every node is copied into its slot. A node that is shared
+	 * by several parents in a lattice is only numbered once.*/
+	num_outcomes = schema.symbols(schema.outcome_column()).size();
+	std::unordered_map<const DecisionTreeNode<T>*,int> ids;
+	std::vector<const DecisionTreeNode<T>*> order;
+	ids[root] = 0;
+	order.push_back(root);
+	for(int n=0;n<order.size();n++){
+		for(int i=0;i<order[n]->children.size();i++){
+			const DecisionTreeNode<T>* child = order[n]->children[i];
+			if(ids.find(child)==ids.end()){
+				ids[child] = order.size();
+				order.push_back(child);
+			};
+		};
+	};
+	nodes.resize(order.size());
+	certainties.assign(order.size()*num_outcomes,0);
+	for(int n=0;n<order.size();n++){
+		nodes[n].item = order[n]->item;
+		nodes[n].condition = order[n]->parent_condition;
+		nodes[n].first_child = child_index.size();
+		nodes[n].num_children = order[n]->children.size();
+		nodes[n].max_certainty = order[n]->max_certainty;
+		for(int i=0;i<order[n]->children.size();i++){
+			child_index.push_back(ids[order[n]->children[i]]);
+		};
+		typename std::pmr::map<int,float>::const_iterator itr;
+		for(itr=order[n]->outcome_certainties.begin();itr!=order[n]->outcome_certainties.end();itr++){
+			certainties[n*num_outcomes+itr->first] = itr->second;
+		};
+	};
+}
+
+template <class T>
+const T& FrozenDecisionTree<T>::item_name(int n)const{
+	if(nodes[n].item<0){
+		return schema.condition(nodes[n].condition);
+	};
+	return schema.decode(nodes[n].condition,nodes[n].item);
+}
+
+template <class T>
+void FrozenDecisionTree<T>::get_best_paths(const QueryMask& query, PathSearch<int>& search, int n)const{
+	/*This is the same depth-first search as DecisionTree's "get_best_paths", only over the indices of
+	 * the nodes. The outcome slots are in the order of the outcomes, and an outcome that never occured
+	 * has a certainty of 0, so it can never be the most certain one.*/
+	const FrozenNode& p = nodes[n];
+	if(p.num_children==0){
+		//BASE CASE
+		const float* outcome_certainties = &certainties[n*num_outcomes];
+		float max_certainty = 0;
+		int certainty_elem = -1;
+		for(int outcome=0;outcome<num_outcomes;outcome++){
+			if(outcome_certainties[outcome] > max_certainty){
+				certainty_elem = outcome;
+				max_certainty = outcome_certainties[outcome];
+			};
+		};
+		search.weigh(search.path,max_certainty,certainty_elem);
+	};
+	//only continue searching path if next entry is in query as well
+	const int* children = child_index.data()+p.first_child;
+	query.for_each_match(p.num_children,
+			[this,children](int i){return std::make_pair(nodes[children[i]].condition,nodes[children[i]].item);},
+			[&](int i){
+		if(nodes[children[i]].max_certainty < search.best_certainty){
+			return;
+		};
+		search.path.push_back(children[i]);
+		get_best_paths(query, search, children[i]);
+		search.path.pop_back();
+	});
+}
+
+template <class T>
+QueryResult<T> FrozenDecisionTree<T>::query(const std::vector<T>& query)const{
+	/*This function finds the same paths as DecisionTree's "query".*/
+	static thread_local std::vector<std::vector<int> > encoded;
+	static thread_local QueryMask mask;
+	static thread_local PathSearch<int> search;
+	schema.encode_query(query,encoded);
+	mask.compile(encoded);
+	search.reset(0);
+	get_best_paths(mask,search,0);
+	const std::vector<int>& outcomes = search.outcomes;
+	QueryResult<T> result;
+	result.root_condition_index = nodes[0].condition;
+	result.root_condition = item_name(0);
+	if(search.num_paths()==0){
+		return result;
+	};
+	result.matched = true;
+	result.certainty = search.best_certainty;
+	const std::vector<int>& final_best_paths = search.distinct_paths(
+			[this](int n){return std::make_pair(nodes[n].condition,nodes[n].item);});
+	result.paths.resize(final_best_paths.size());
+	for(int i=0;i<final_best_paths.size();i++){
+		QueryPath<T>& path = result.paths[i];
+		int k = final_best_paths[i];
+		if(outcomes[k]>=0){
+			path.outcome = schema.decode(schema.outcome_column(),outcomes[k]);
+		};
+		path.features.reserve(search.path_end(k)-search.path_begin(k)-1);
+		for(int j=search.path_begin(k)+1;j<search.path_end(k);j++){
+			int n = search.best_nodes[j];
+			path.features.push_back(std::make_pair(schema.condition(nodes[n].condition),item_name(n)));
+		};
+	};
+	return result;
+}
+
+template <class T>
+void FrozenDecisionTree<T>::print_best_paths_for_query(const std::vector<T>& query)const{
+	/*This function prints the same paths as DecisionTree's "print_best_paths_for_query".*/
+	print_query_result(this->query(query));
+}
+
+template <class T>
+void FrozenDecisionTree<T>::print_all_paths(std::ostream& ostr, int n, std::vector<int>& path)const{
+	/* This recursive function prints all the paths in the tree using a depth-first search (the path is a
+	 * stack, as in DecisionTree's "print_all_paths").*/
+	const FrozenNode& p = nodes[n];
+	if(p.num_children==0){
+		ostr << "General Outcomes for path:";
+		for(int i = 1;i<path.size();i++){
+			ostr << ' ' << item_name(path[i]);
+		};
+		ostr << std::endl;
+		for(int outcome=0;outcome<num_outcomes;outcome++){
+			if(certainties[n*num_outcomes+outcome]>0){
+				ostr << "   "<< schema.decode(schema.outcome_column(),outcome) << ' '
+					<< certainties[n*num_outcomes+outcome] << std::endl;
+			};
+		};
+	};
+	for(int i=0;i<p.num_children;i++){
+		path.push_back(child_index[p.first_child+i]);
+		print_all_paths(ostr, child_index[p.first_child+i], path);
+		path.pop_back();
+	};
+}
+
+template <class T>
+void FrozenDecisionTree<T>::print_all_paths(std::ostream& ostr)const{
+	//DRIVER FOR PRINT_ALL_PATHS
+	std::vector<int> path(1,0);
+	print_all_paths(ostr,0,path);
+}
+
+
+enum RootSelection{
+	HIGHEST_CERTAINTY,
+	//The tree whose best paths are the most certain answers (the first tree on a tie)
+	FIRST_SUPPORTED
+	//The first tree, in the order of the roots, with a path of at least one feature that matches
+};
+
+template <class T>
+class DecisionForest{
+	/* This class builds the DecisionTree of every root condition at once, so the root no longer has to be
+	 * picked by hand by rebuilding the tree with one root after another until one of them answers a query.
+	 * The trees share one copy of the table (and of its bitmap index), and since a set of features has
+	 * the same counts whatever root it was reached from, every set is only counted by the first tree that
+	 * reaches it (see CountCache). A query is then answered by the tree that "RootSelection" picks.*/
+	private:
+	//MEMBER VARIABLES
+	std::vector<int> roots;
+	//The root condition of every tree, in the order the trees are preferred
+	std::vector<std::unique_ptr<DecisionTree<T> > > trees;
+	//The tree of every root
+
+	//UTILITIES
+	void init(const std::shared_ptr<const EncodedTable<T> >& table, const std::vector<int>& root_order,
+			int min_occur, float prune, const TreeOptions& opts);
+	//A utility for the constructors that builds every tree
+	QueryResult<T> answer(const std::vector<T>& query, RootSelection policy, int& chosen)const;
+	//A utility for "select_tree" and "query" that queries the trees until the policy settles on one
+
+	public:
+	//CONSTRUCTORS
+	DecisionForest(const std::vector<T>& conditions, const std::vector<std::vector<T> >& data,
+			int min_occur, float prune, const std::vector<int>& root_order=std::vector<int>(),
+			const TreeOptions& opts=TreeOptions());
+	DecisionForest(const EncodedTable<T>& data, int min_occur, float prune,
+			const std::vector<int>& root_order=std::vector<int>(), const TreeOptions& opts=TreeOptions());
+	//ACCESSORS
+	int num_trees()const{return trees.size();}
+	const DecisionTree<T>& tree(int i)const{return *trees[i];}
+	//The tree of the i-th root in "root_order"
+	int root_condition(int i)const{return roots[i];}
+	const DecisionTree<T>& tree_for_root(int condition)const;
+	//The tree whose root is the given condition (which must be one of the roots of the forest)
+	int get_size()const;
+	//The number of nodes in every tree together
+
+	//PUBLIC UTILITIES
+	int select_tree(const std::vector<T>& query, RootSelection policy=HIGHEST_CERTAINTY)const;
+	//The index of the tree that answers a query (-1 if none matches it)
+	QueryResult<T> query(const std::vector<T>& query, RootSelection policy=HIGHEST_CERTAINTY)const;
+	//The best paths of the tree that answers a query
+	std::vector<QueryResult<T> > query_all(const std::vector<std::vector<T> >& queries,
+			RootSelection policy=HIGHEST_CERTAINTY)const;
+	//What "query" finds for every query, with each tree searched once for all the queries it may answer
+	void print_best_paths_for_query(const std::vector<T>& query, RootSelection policy=HIGHEST_CERTAINTY)const;
+	//Prints the best paths of the tree that answers a query
+};
+
+template <class T>
+DecisionForest<T>::DecisionForest(const std::vector<T>& conditions, const std::vector<std::vector<T> >& data,
+		int min_occur, float prune, const std::vector<int>& root_order, const TreeOptions& opts){
+	init(DecisionTree<T>::sorted_table(EncodedTable<T>(conditions,data)),root_order,min_occur,prune,opts);
+}
+
+template <class T>
+DecisionForest<T>::DecisionForest(const EncodedTable<T>& data, int min_occur, float prune,
+		const std::vector<int>& root_order, const TreeOptions& opts){
+	init(DecisionTree<T>::sorted_table(data),root_order,min_occur,prune,opts);
+}
+
+template <class T>
+void DecisionForest<T>::init(const std::shared_ptr<const EncodedTable<T> >& table,
+		const std::vector<int>& root_order, int min_occur, float prune, const TreeOptions& opts){
+	/*Without an order, every condition is a root in the order of the conditions. The trees are built one
+	 * after another (each on "threads" workers), so the later trees find most of their counts cached.*/
+	roots = root_order;
+	if(roots.empty()){
+		for(int i=0;i<table->num_conditions();i++){
+			roots.push_back(i);
+		};
+	};
+	std::shared_ptr<const BitmapIndex> index;
+	if(opts.counting==BITMAP_INDEX){
+		index.reset(new BitmapIndex(*table));
+	};
+	std::shared_ptr<const ContingencyCube> cube;
+	if(opts.counting==CONTINGENCY_CUBE){
+		cube.reset(new ContingencyCube(*table));
+	};
+	std::shared_ptr<CountCache> counts(new CountCache());
+	for(int i=0;i<roots.size();i++){
+		trees.push_back(std::unique_ptr<DecisionTree<T> >(
+					new DecisionTree<T>(table,index,cube,counts,roots[i],min_occur,prune,opts)));
+	};
+}
+
+template <class T>
+const DecisionTree<T>& DecisionForest<T>::tree_for_root(int condition)const{
+	int i = std::find(roots.begin(),roots.end(),condition)-roots.begin();
+	return *trees[i];
+}
+
+template <class T>
+int DecisionForest<T>::get_size()const{
+	int size = 0;
+	for(int i=0;i<trees.size();i++){
+		size += trees[i]->get_size();
+	};
+	return size;
+}
+
+template <class T>
+QueryResult<T> DecisionForest<T>::answer(const std::vector<T>& query, RootSelection policy, int& chosen)const{
+	QueryResult<T> best;
+	chosen = -1;
+	for(int i=0;i<trees.size();i++){
+		QueryResult<T> result = trees[i]->query(query);
+		if(policy==FIRST_SUPPORTED){
+			if(result.supported()){
+				chosen = i;
+				return result;
+			};
+		}
+		else if(result.matched && result.certainty > best.certainty){
+			chosen = i;
+			best = result;
+		};
+	};
+	return best;
+}
+
+template <class T>
+int DecisionForest<T>::select_tree(const std::vector<T>& query, RootSelection policy)const{
+	int chosen;
+	answer(query,policy,chosen);
+	return chosen;
+}
+
+template <class T>
+QueryResult<T> DecisionForest<T>::query(const std::vector<T>& query, RootSelection policy)const{
+	int chosen;
+	return answer(query,policy,chosen);
+}
+
+template <class T>
+std::vector<QueryResult<T> > DecisionForest<T>::query_all(const std::vector<std::vector<T> >& queries,
+		RootSelection policy)const{
+	/*The trees are asked in order as in "answer", but each with every query that is not settled yet (see
+	 * DecisionTree's "query_all"), so a whole list of matches takes one search of each tree.*/
+	std::vector<QueryResult<T> > results(queries.size());
+	std::vector<int> pending;
+	for(int i=0;i<queries.size();i++){
+		pending.push_back(i);
+	};
+	for(int i=0;i<trees.size() && !pending.empty();i++){
+		std::vector<std::vector<T> > batch;
+		for(int k=0;k<pending.size();k++){
+			batch.push_back(queries[pending[k]]);
+		};
+		std::vector<QueryResult<T> > answers = trees[i]->query_all(batch);
+		std::vector<int> unsettled;
+		for(int k=0;k<pending.size();k++){
+			QueryResult<T>& best = results[pending[k]];
+			if(policy==FIRST_SUPPORTED){
+				if(answers[k].supported()){
+					best = answers[k];
+				}
+				else{
+					unsettled.push_back(pending[k]);
+				};
+			}
+			else{
+				if(answers[k].matched && answers[k].certainty > best.certainty){
+					best = answers[k];
+				};
+				unsettled.push_back(pending[k]);
+			};
+		};
+		pending.swap(unsettled);
+	};
+	return results;
+}
+
+template <class T>
+void DecisionForest<T>::print_best_paths_for_query(const std::vector<T>& query, RootSelection policy)const{
+	print_query_result(this->query(query,policy));
+}
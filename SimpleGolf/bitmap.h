@@ -0,0 +1,227 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+#include <vector>
+#include <cstdint>
+#include "table.h"
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BITMAP_X86 1
+#endif
+/*This header file is comprised by the bitmap index of an encoded table and the kernels that
+ * operate on it. The index keeps one bitmap of rows for every feature of every column, where
+ * bit i of a bitmap is set when row i of the table holds that feature. Counting the rows that
+ * match a set of features is then a matter of and-ing a few bitmaps together and counting the
+ * bits that are left (a popcount). The kernels use AVX-512 or AVX2 when the CPU supports them
+ * and fall back to plain 64-bit words otherwise.*/
+
+//SCALAR KERNELS
+inline int bitmap_and_count_scalar(const uint64_t* a, const uint64_t* b, int words){
+	int count = 0;
+	for(int i=0;i<words;i++){
+		count += __builtin_popcountll(a[i]&b[i]);
+	};
+	return count;
+}
+
+inline int bitmap_and_into_scalar(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words){
+	int count = 0;
+	for(int i=0;i<words;i++){
+		dst[i] = a[i]&b[i];
+		count += __builtin_popcountll(dst[i]);
+	};
+	return count;
+}
+
+#ifdef BITMAP_X86
+//AVX2 KERNELS
+/*AVX2 has no popcount instruction, so the bits of every byte are counted with a lookup
+ * table of nibbles and the bytes are then summed into 64-bit lanes.*/
+__attribute__((target("avx2"))) inline __m256i popcount_avx2(__m256i v){
+	const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+						0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+	const __m256i low_mask = _mm256_set1_epi8(0x0f);
+	__m256i lo = _mm256_and_si256(v,low_mask);
+	__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v,4),low_mask);
+	__m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup,lo),_mm256_shuffle_epi8(lookup,hi));
+	return _mm256_sad_epu8(bytes,_mm256_setzero_si256());
+}
+
+__attribute__((target("avx2"))) inline int sum_lanes_avx2(__m256i acc){
+	uint64_t lanes[4];
+	_mm256_storeu_si256((__m256i*)lanes,acc);
+	return lanes[0]+lanes[1]+lanes[2]+lanes[3];
+}
+
+__attribute__((target("avx2"))) inline int bitmap_and_count_avx2(const uint64_t* a, const uint64_t* b, int words){
+	__m256i acc = _mm256_setzero_si256();
+	int i=0;
+	for(;i+4<=words;i+=4){
+		__m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a+i)),
+				_mm256_loadu_si256((const __m256i*)(b+i)));
+		acc = _mm256_add_epi64(acc,popcount_avx2(v));
+	};
+	return sum_lanes_avx2(acc)+bitmap_and_count_scalar(a+i,b+i,words-i);
+}
+
+__attribute__((target("avx2"))) inline int bitmap_and_into_avx2(uint64_t* dst, const uint64_t* a,
+		const uint64_t* b, int words){
+	__m256i acc = _mm256_setzero_si256();
+	int i=0;
+	for(;i+4<=words;i+=4){
+		__m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a+i)),
+				_mm256_loadu_si256((const __m256i*)(b+i)));
+		_mm256_storeu_si256((__m256i*)(dst+i),v);
+		acc = _mm256_add_epi64(acc,popcount_avx2(v));
+	};
+	return sum_lanes_avx2(acc)+bitmap_and_into_scalar(dst+i,a+i,b+i,words-i);
+}
+
+//AVX-512 KERNELS
+__attribute__((target("avx512f"))) inline int sum_lanes_avx512(__m512i acc){
+	//the lanes are added one by one, as GCC's _mm512_reduce_add_epi64 warns of an uninitialized value under -Wall
+	uint64_t lanes[8];
+	_mm512_storeu_si512(lanes,acc);
+	return lanes[0]+lanes[1]+lanes[2]+lanes[3]+lanes[4]+lanes[5]+lanes[6]+lanes[7];
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline int bitmap_and_count_avx512(const uint64_t* a,
+		const uint64_t* b, int words){
+	__m512i acc = _mm512_setzero_si512();
+	int i=0;
+	for(;i+8<=words;i+=8){
+		__m512i v = _mm512_and_si512(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i));
+		acc = _mm512_add_epi64(acc,_mm512_popcnt_epi64(v));
+	};
+	return sum_lanes_avx512(acc)+bitmap_and_count_scalar(a+i,b+i,words-i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline int bitmap_and_into_avx512(uint64_t* dst,
+		const uint64_t* a, const uint64_t* b, int words){
+	__m512i acc = _mm512_setzero_si512();
+	int i=0;
+	for(;i+8<=words;i+=8){
+		__m512i v = _mm512_and_si512(_mm512_loadu_si512(a+i),_mm512_loadu_si512(b+i));
+		_mm512_storeu_si512(dst+i,v);
+		acc = _mm512_add_epi64(acc,_mm512_popcnt_epi64(v));
+	};
+	return sum_lanes_avx512(acc)+bitmap_and_into_scalar(dst+i,a+i,b+i,words-i);
+}
+#endif
+
+//DISPATCH
+enum BitmapKernel{SCALAR_KERNEL, AVX2_KERNEL, AVX512_KERNEL};
+
+inline BitmapKernel bitmap_kernel(){
+	/*The instruction set is checked once and the widest kernel the CPU supports is used from then on.*/
+	static const BitmapKernel kernel = [](){
+#ifdef BITMAP_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq")){
+			return AVX512_KERNEL;
+		};
+		if(__builtin_cpu_supports("avx2")){
+			return AVX2_KERNEL;
+		};
+#endif
+		return SCALAR_KERNEL;
+	}();
+	return kernel;
+}
+
+inline int bitmap_and_count(const uint64_t* a, const uint64_t* b, int words){
+	//Counts the bits set in both a and b
+#ifdef BITMAP_X86
+	switch(bitmap_kernel()){
+		case AVX512_KERNEL: return bitmap_and_count_avx512(a,b,words);
+		case AVX2_KERNEL: return bitmap_and_count_avx2(a,b,words);
+		default: break;
+	};
+#endif
+	return bitmap_and_count_scalar(a,b,words);
+}
+
+inline int bitmap_and_into(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words){
+	//Stores a and b in dst and counts the bits that are set
+#ifdef BITMAP_X86
+	switch(bitmap_kernel()){
+		case AVX512_KERNEL: return bitmap_and_into_avx512(dst,a,b,words);
+		case AVX2_KERNEL: return bitmap_and_into_avx2(dst,a,b,words);
+		default: break;
+	};
+#endif
+	return bitmap_and_into_scalar(dst,a,b,words);
+}
+
+//WEIGHTED COUNTS
+/*When the rows of a table are weighted, the bits of a bitmap are not all worth the same, so the set bits
+ * are walked one by one and the weight of each of their rows is added up instead of counted.*/
+inline int bitmap_weigh(const uint64_t* a, const int* weights, int words){
+	//Adds up the weights of the rows set in a
+	int total = 0;
+	for(int i=0;i<words;i++){
+		uint64_t bits = a[i];
+		while(bits){
+			total += weights[i*64+__builtin_ctzll(bits)];
+			bits &= bits-1;
+		};
+	};
+	return total;
+}
+
+inline int bitmap_and_weigh(const uint64_t* a, const uint64_t* b, const int* weights, int words){
+	//Adds up the weights of the rows set in both a and b
+	int total = 0;
+	for(int i=0;i<words;i++){
+		uint64_t bits = a[i]&b[i];
+		while(bits){
+			total += weights[i*64+__builtin_ctzll(bits)];
+			bits &= bits-1;
+		};
+	};
+	return total;
+}
+
+
+class BitmapIndex{
+	/*This class holds a bitmap of rows for every (column, feature) pair of an encoded table,
+	 * the outcome column included. The bitmaps of a column are stored back to back in one
+	 * vector so that a column's features are contiguous in memory.*/
+	private:
+	//MEMBER VARIABLES
+	int words;
+	//The number of 64-bit words in each bitmap
+	std::vector<std::vector<uint64_t> > bitmaps;
+	//The bitmaps of every column, one after the other by code
+	std::vector<uint64_t> all_rows;
+	//A bitmap with a bit set for every row in the table
+
+	public:
+	//CONSTRUCTORS
+	BitmapIndex(){words=0;}
+	template <class T>
+	BitmapIndex(const EncodedTable<T>& table);
+
+	//ACCESSORS
+	int num_words()const{return words;}
+	const uint64_t* bitmap(int column, int code)const{return &bitmaps[column][code*words];}
+	const uint64_t* rows()const{return all_rows.data();}
+};
+
+template <class T>
+BitmapIndex::BitmapIndex(const EncodedTable<T>& table){
+	/*A single pass over each column sets the bit of every row in the bitmap of its feature.*/
+	words = (table.rows()+63)/64;
+	bitmaps.resize(table.width());
+	for(int c=0;c<table.width();c++){
+		bitmaps[c].assign(table.symbols(c).size()*words,0);
+		const std::vector<int>& column = table.column(c);
+		for(int i=0;i<table.rows();i++){
+			bitmaps[c][column[i]*words+i/64] |= (uint64_t)1 << (i%64);
+		};
+	};
+	all_rows.assign(words,0);
+	for(int i=0;i<table.rows();i++){
+		all_rows[i/64] |= (uint64_t)1 << (i%64);
+	};
+}
+#endif
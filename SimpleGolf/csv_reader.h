@@ -0,0 +1,291 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <charconv>
+#include <memory>
+#include "table.h"
+#include "thread_pool.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CSV_MMAP 1
+#endif
+/*This header file is comprised by a reader for the comma-separated data files. Rather than reading a
+ * file line by line into strings and building every field a character at a time, the whole file is
+ * mapped into memory and every field is handed out as a view into the mapped file, so a row only costs
+ * a few pointers until it is kept. Features such as team names are stored with underscores in place
+ * of their spaces, and that is only done for the fields that are kept, when they are turned into strings
+ * (or compared as if it had been done, see "field_equals"). Large files can be read by several threads at
+ * once, each reading and encoding a chunk of the rows (see "read_csv").*/
+
+class MappedFile{
+	/*This class maps a file into memory for reading and unmaps it once it goes out of scope. Where
+	 * files cannot be mapped, the file is read into memory instead.*/
+	private:
+	//MEMBER VARIABLES
+	const char* data;
+	//The first character of the file
+	size_t length;
+	//The number of characters in the file
+	bool mapped;
+	//Whether "data" is a mapping (rather than "buffer")
+	std::string buffer;
+	//The contents of the file when it is not mapped
+	bool opened;
+	//Whether the file could be read
+
+	public:
+	//CONSTRUCTORS
+	MappedFile(const std::string& path);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	//ACCESSORS
+	bool is_open()const{return opened;}
+	std::string_view contents()const{return std::string_view(data,length);}
+	//DESTRUCTOR
+	~MappedFile();
+};
+
+inline MappedFile::MappedFile(const std::string& path){
+	data = NULL;
+	length = 0;
+	mapped = false;
+	opened = false;
+#ifdef CSV_MMAP
+	int fd = open(path.c_str(),O_RDONLY);
+	if(fd>=0){
+		struct stat info;
+		if(fstat(fd,&info)==0 && info.st_size>0){
+			void* p = mmap(NULL,info.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+			if(p!=MAP_FAILED){
+				//the file is read from front to back
+				madvise(p,info.st_size,MADV_SEQUENTIAL);
+				data = (const char*)p;
+				length = info.st_size;
+				mapped = true;
+			};
+		};
+		close(fd);
+		if(mapped){
+			opened = true;
+			return;
+		};
+	};
+#endif
+	std::ifstream file(path.c_str(),std::ios::binary);
+	if(!file){
+		return;
+	};
+	std::ostringstream contents;
+	contents << file.rdbuf();
+	buffer = contents.str();
+	data = buffer.data();
+	length = buffer.size();
+	opened = true;
+}
+
+inline MappedFile::~MappedFile(){
+#ifdef CSV_MMAP
+	if(mapped){
+		munmap((void*)data,length);
+	};
+#endif
+}
+
+
+class CsvReader{
+	/*This class splits text into rows and fields. A row is a line of the text (a carriage return
+	 * before the newline is dropped), empty lines are skipped, and the fields of a row are the pieces
+	 * between the delimiters. The fields are views into the text, so they are only valid as long as
+	 * the text is.*/
+	private:
+	//MEMBER VARIABLES
+	std::string_view text;
+	size_t position;
+	//Where the next row starts
+	char delimiter;
+
+	public:
+	//CONSTRUCTORS
+	CsvReader(std::string_view t, char d=','){text=t;position=0;delimiter=d;}
+	//MODIFIERS
+	bool next_line(std::string_view& line);
+	//Reads the next line that is not empty (false at the end of the text)
+	bool next_row(std::vector<std::string_view>& fields);
+	//Reads the next line and splits it into its fields (false at the end of the text)
+};
+
+inline bool CsvReader::next_line(std::string_view& line){
+	while(position<text.size()){
+		size_t end = text.find('\n',position);
+		if(end==std::string_view::npos){
+			end = text.size();
+		};
+		line = text.substr(position,end-position);
+		position = end+1;
+		if(!line.empty() && line.back()=='\r'){
+			line.remove_suffix(1);
+		};
+		if(!line.empty()){
+			return true;
+		};
+	};
+	return false;
+}
+
+inline bool CsvReader::next_row(std::vector<std::string_view>& fields){
+	std::string_view line;
+	if(!next_line(line)){
+		return false;
+	};
+	fields.clear();
+	size_t start = 0;
+	while(true){
+		size_t end = line.find(delimiter,start);
+		if(end==std::string_view::npos){
+			fields.push_back(line.substr(start));
+			return true;
+		};
+		fields.push_back(line.substr(start,end-start));
+		start = end+1;
+	};
+}
+
+//FIELD UTILITIES
+inline std::string normalize_field(std::string_view field){
+	//A field as it is stored, with underscores in place of its spaces
+	std::string ret(field);
+	for(int i=0;i<ret.size();i++){
+		if(ret[i]==' '){
+			ret[i] = '_';
+		};
+	};
+	return ret;
+}
+
+inline bool field_equals(std::string_view field, const std::string& normalized){
+	//Whether a field is the same as a stored feature, without making a string of the field
+	if(field.size()!=normalized.size()){
+		return false;
+	};
+	for(int i=0;i<field.size();i++){
+		if((field[i]==' ' ? '_' : field[i])!=normalized[i]){
+			return false;
+		};
+	};
+	return true;
+}
+
+inline int parse_int(std::string_view field){
+	//The integer at the start of a field (0 if there is none)
+	int value = 0;
+	std::from_chars(field.data(),field.data()+field.size(),value);
+	return value;
+}
+
+inline std::vector<std::string_view> split_chunks(std::string_view text, int num_chunks){
+	/*Splits text into about "num_chunks" pieces of the same size, each ending at the end of a line, so
+	 * that every line is in exactly one chunk and the chunks are in the order of the text.*/
+	std::vector<std::string_view> chunks;
+	size_t start = 0;
+	for(int k=1;k<=num_chunks && start<text.size();k++){
+		size_t end = k==num_chunks ? text.size() : text.size()/num_chunks*k;
+		if(end<start){
+			end = start;
+		};
+		end = text.find('\n',end);
+		end = end==std::string_view::npos ? text.size() : end+1;
+		chunks.push_back(text.substr(start,end-start));
+		start = end;
+	};
+	return chunks;
+}
+
+template <class Filter>
+void read_csv_chunk(std::string_view chunk, int width, Filter keep, const std::vector<int>& columns,
+		EncodedTable<std::string>& table){
+	//Encodes the given columns of the rows of a chunk that have "width" fields and that "keep" accepts
+	CsvReader reader(chunk);
+	std::vector<std::string_view> fields;
+	std::vector<std::string> row(columns.size());
+	while(reader.next_row(fields)){
+		if(fields.size()!=width || !keep(fields)){
+			continue;
+		};
+		for(int i=0;i<columns.size();i++){
+			//the strings of the row are reused, so a row only allocates for features that are longer than before
+			row[i].assign(fields[columns[i]].data(),fields[columns[i]].size());
+			for(int c=0;c<row[i].size();c++){
+				if(row[i][c]==' '){
+					row[i][c] = '_';
+				};
+			};
+		};
+		table.add_row(row);
+	};
+}
+
+template <class Filter>
+EncodedTable<std::string> read_csv(const MappedFile& file, int threads, Filter keep, std::vector<int> columns){
+	/*Reads a comma-separated file with a header row into an encoded table, keeping the rows that "keep"
+	 * accepts (it is handed the fields of a row as views, from several threads at once when there are
+	 * several threads) and that have as many fields as the header. Only the given columns of the file
+	 * are encoded, in the order they are given (every column when there are none), so the fields of the
+	 * other columns and of the rows that are not kept are never copied.
+	 * With several threads, the rows after the header are split into chunks at line ends, every chunk is
+	 * read and encoded into a table of its own on a WorkStealingPool, and the tables are then appended in
+	 * order, which reconciles their symbol tables. The table is the same however many threads read it.*/
+	CsvReader reader(file.contents());
+	std::string_view header;
+	if(!reader.next_line(header)){
+		return EncodedTable<std::string>();
+	};
+	std::vector<std::string_view> names;
+	CsvReader(header).next_row(names);
+	if(columns.empty()){
+		for(int i=0;i<names.size();i++){
+			columns.push_back(i);
+		};
+	};
+	std::vector<std::string> conditions;
+	for(int i=0;i<columns.size();i++){
+		if(columns[i]<0 || columns[i]>=names.size()){
+			return EncodedTable<std::string>();
+		};
+		conditions.push_back(std::string(names[columns[i]]));
+	};
+	std::string_view body = file.contents().substr(header.data()-file.contents().data()+header.size());
+	EncodedTable<std::string> table(conditions);
+	if(threads<=1){
+		read_csv_chunk(body,names.size(),keep,columns,table);
+		return table;
+	};
+	//a few chunks per thread keep the threads busy when some chunks keep more rows than others
+	std::vector<std::string_view> chunks = split_chunks(body,threads*4);
+	std::vector<EncodedTable<std::string> > chunk_tables(chunks.size(),EncodedTable<std::string>(conditions));
+	{
+		WorkStealingPool pool(threads);
+		for(int k=0;k<chunks.size();k++){
+			pool.submit([&chunks,&chunk_tables,&names,&keep,&columns,k](){
+				read_csv_chunk(chunks[k],names.size(),keep,columns,chunk_tables[k]);
+			});
+		};
+		pool.wait();
+	}
+	for(int k=0;k<chunk_tables.size();k++){
+		table.append(chunk_tables[k]);
+	};
+	return table;
+}
+
+template <class Filter>
+EncodedTable<std::string> read_csv(const MappedFile& file, int threads, Filter keep){
+	return read_csv(file,threads,keep,std::vector<int>());
+}
+#endif
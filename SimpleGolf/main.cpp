@@ -1,98 +1,85 @@
-#include "tree.h"
-#include <map>
-#include <vector>
-#include <cctype>
-#include <algorithm>
-#include <set>
-#include <iostream>
-#include <fstream>
-#include <set>
-//For weighting certain input, weights must be specified coming in
-std::string lowerfy(const std::string& s){
-	std::string ret="";
-	for(int i=0;i<s.length();i++){
-		ret+=tolower(s[i]);
-	};
-return ret;
-}
-
-
-
-int main(int argc, char *argv[]){
-if(argc!=2){
-	std::cerr << "Need an input file.";
-	exit(1);
-};
-if(!argv[1]){
-	std::cerr << "ERROR: The file could not be opened for reading.";
-	exit(1);
-};
-std::vector<std::vector<std::string> > dataTable;
-/*Using vector approach, everything sequence must correspond to the conditions given (not likely we are going to know all the conditions we want => thus conditions are limited to what we can know)*/
-/*Also have to ensure that no features or conditions in text file are two words (can change at end by looking for capital letters, the start of a capital letter meaning a new word)*/
-//get counts of occurences to examine certainty/probability rates
-//associate a type of phenomenon with all the outcomes for all conditions;
-//need to build a tree out of the phenomenon that ocurr
-//change to user interface, use stdout for now
-std::string condition;
-std::vector<std::string> conditions;
-std::ifstream dataFile(argv[1]);
-//certain types of conditions are factors that produce the final output
-//a general condition has specific conditions associated with it (could be object-oriented if need be)
-while(condition!="quit"){
-	dataFile >> condition;	
-	if(condition!="quit"){
-	conditions.push_back(condition);
-	};
-};
-std::string first_element;
-while(dataFile >> first_element){
-	if(first_element=="query"){
-		break;
-	};
-	std::vector<std::string> subVec;
-	subVec.push_back(first_element);
-	std::string sub;
-	for(int i=1;i<conditions.size();i++){
-		dataFile >> sub;
-		subVec.push_back(sub);
-	};
-	dataTable.push_back(subVec);
-	subVec.clear();
-};
-//read in the query;
-std::vector<std::string> query_features;
-std::string query;
-while(dataFile >> query){
-	query_features.push_back(query);
-};
-//have data
-//checking data
-//can uncomment to check all the data
-/*
-for(int i = 0;i<conditions.size();i++){
-	std::cout << conditions[i] << ' ';
-};
-std::cout << std::endl;
-for(int i=0;i<dataTable.size();i++){
- for(int j=0;j<dataTable[i].size();j++){
-	std::cout << dataTable[i][j] << ' ';	
- };
- std::cout << std::endl;
-};
-std::cout << "Query:";
-for(int i = 0;i<query_features.size();i++){
-	std::cout << ' ' << query_features[i];
-};
-std::cout << std::endl;
-*/
-//need to specify a root_condition_index for the tree in addition to the iterator associated with that "index"
-DecisionTree<std::string> dt(conditions,dataTable,0,4,.75);
-//Possible root_condition_indices: [0..3]
-//Printing outcomes
-dt.print_best_paths_for_query(query_features);
-//Visualize tree with print_all_paths
-//dt.print_all_paths(std::cout);
-//Uncomment to print all paths
-return 0;
-}
+#include "tree.h"
+#include "table_reader.h"
+#include <map>
+#include <vector>
+#include <cctype>
+#include <algorithm>
+#include <set>
+#include <iostream>
+#include <fstream>
+#include <set>
+//For weighting certain input, weights must be specified coming in
+std::string lowerfy(const std::string& s){
+	std::string ret="";
+	for(int i=0;i<s.length();i++){
+		ret+=tolower(s[i]);
+	};
+return ret;
+}
+
+
+
+int main(int argc, char *argv[]){
+if(argc!=2){
+	std::cerr << "Need an input file (or - to read from standard input).";
+	exit(1);
+};
+if(!argv[1]){
+	std::cerr << "ERROR: The file could not be opened for reading.";
+	exit(1);
+};
+/*Using vector approach, everything sequence must correspond to the conditions given (not likely we are going to know all the conditions we want => thus conditions are limited to what we can know)*/
+/*Also have to ensure that no features or conditions in text file are two words (can change at end by looking for capital letters, the start of a capital letter meaning a new word)*/
+//get counts of occurences to examine certainty/probability rates
+//associate a type of phenomenon with all the outcomes for all conditions;
+//need to build a tree out of the phenomenon that ocurr
+//change to user interface, use stdout for now
+bool from_stdin = std::string(argv[1])=="-";
+MappedFile file(from_stdin ? std::string() : std::string(argv[1]));
+if(!from_stdin && !file.is_open()){
+	std::cerr << "ERROR: The file could not be opened for reading.";
+	exit(1);
+};
+/*With "-" as the file, the table is read from standard input, so it can be piped in from a feed of
+ * any length: the rows are counted as they are read and never stored one by one (see StreamingTable).
+ * Either way the words of the file are read in bulk (see table_reader.h).*/
+TokenReader dataFile = from_stdin ? TokenReader(std::cin) : TokenReader(file.contents());
+//certain types of conditions are factors that produce the final output
+//a general condition has specific conditions associated with it (could be object-oriented if need be)
+std::vector<std::string> conditions = read_conditions(dataFile);
+StreamingTable<std::string> dataTable(conditions);
+read_rows(dataFile,conditions.size(),[&dataTable](const std::vector<std::string>& row){
+	dataTable.add_row(row);
+});
+//read in the query;
+std::vector<std::string> query_features = read_query(dataFile);
+//have data
+//checking data
+//can uncomment to check all the data
+/*
+for(int i = 0;i<conditions.size();i++){
+	std::cout << conditions[i] << ' ';
+};
+std::cout << std::endl;
+for(int i=0;i<dataTable.distinct_rows();i++){
+ for(int j=0;j<dataTable.table().width();j++){
+	std::cout << dataTable.table().decode(j,dataTable.table().at(i,j)) << ' ';
+ };
+ std::cout << "(x" << dataTable.table().weight(i) << ')' << std::endl;
+};
+std::cout << "Query:";
+for(int i = 0;i<query_features.size();i++){
+	std::cout << ' ' << query_features[i];
+};
+std::cout << std::endl;
+*/
+//need to specify a root_condition_index for the tree in addition to the iterator associated with that "index"
+DecisionTree<std::string> dt(dataTable.table(),0,4,.75);
+//Possible root_condition_indices: [0..3]
+//Printing outcomes
+dt.print_best_paths_for_query(query_features);
+//Visualize tree with print_all_paths
+//dt.print_all_paths(std::cout);
+//Uncomment to print all paths
+return 0;
+}
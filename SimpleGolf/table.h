@@ -0,0 +1,452 @@
+#ifndef TABLE_H
+#define TABLE_H
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <algorithm>
+/*This header file is comprised by the columnar data table that the DecisionTree is built on
+ * and the symbol tables that encode it. Rather than storing the data table as rows of features
+ * and comparing those features one by one, every column of the table is dictionary-encoded: each
+ * distinct feature in a column is given a small integer code by the symbol table of that column,
+ * and the column itself is stored as one contiguous vector of codes. The decision tree is built
+ * and queried on the codes and only decodes them back into features when it prints.*/
+template <class T>
+class SymbolTable{
+	/*This class maps the distinct features of a single column to integer codes and back.
+	 * Codes are handed out in order of first appearance, but they can be renumbered so that
+	 * the order of the codes is the order of the features themselves.*/
+	private:
+	//MEMBER VARIABLES
+	std::unordered_map<T,int> codes;
+	//The code of every feature in the column
+	std::vector<T> symbols;
+	//The feature of every code in the column
+
+	public:
+	//ACCESSORS
+	int size()const{return symbols.size();}
+	const T& decode(int code)const{return symbols[code];}
+	//Returns the feature that a code stands for
+	int lookup(const T& symbol)const;
+	//Returns the code of a feature, or -1 if the feature does not occur in the column
+
+	//MODIFIERS
+	int encode(const T& symbol);
+	//Returns the code of a feature, adding the feature to the table if it is new
+	std::vector<int> sort_symbols();
+	//Renumbers the codes in the order of the features, returning the new code of every old code
+};
+
+template <class T>
+int SymbolTable<T>::lookup(const T& symbol)const{
+	typename std::unordered_map<T,int>::const_iterator itr = codes.find(symbol);
+	if(itr==codes.end()){
+		return -1;
+	};
+	return itr->second;
+}
+
+template <class T>
+int SymbolTable<T>::encode(const T& symbol){
+	/*A feature that has not been seen before simply takes the next code.*/
+	typename std::unordered_map<T,int>::iterator itr = codes.find(symbol);
+	if(itr!=codes.end()){
+		return itr->second;
+	};
+	int code = symbols.size();
+	codes[symbol] = code;
+	symbols.push_back(symbol);
+	return code;
+}
+
+template <class T>
+std::vector<int> SymbolTable<T>::sort_symbols(){
+	/*This function sorts the features of the column and gives each feature the code of its
+	 * position in that order. The returned vector is indexed by the old code so that a column
+	 * that was encoded with the old codes can be renumbered in a single pass.*/
+	std::vector<int> order(symbols.size());
+	for(int i=0;i<order.size();i++){
+		order[i] = i;
+	};
+	std::sort(order.begin(),order.end(),[this](int a, int b){return symbols[a] < symbols[b];});
+	std::vector<int> remap(symbols.size());
+	std::vector<T> sorted_symbols(symbols.size());
+	for(int i=0;i<order.size();i++){
+		remap[order[i]] = i;
+		sorted_symbols[i] = symbols[order[i]];
+		codes[sorted_symbols[i]] = i;
+	};
+	symbols.swap(sorted_symbols);
+	return remap;
+}
+
+
+template <class T>
+class EncodedTable{
+	/*This class represents a data table in columnar form. The table has a name for every condition
+	 * followed by the name of the outcome, just as the first line of the data files, and every row
+	 * of the table is split into its columns where each column holds the codes of its features. The
+	 * last column of a row is always the outcome. Note that the features of every column can be
+	 * sorted so that comparing two codes is the same as comparing the features they stand for.*/
+	private:
+	//MEMBER VARIABLES
+	std::vector<T> conditions;
+	//The name of every condition (the last name refers to the outcome)
+	std::vector<SymbolTable<T> > symbol_tables;
+	//One symbol table per column
+	std::vector<std::vector<int> > columns;
+	//The codes of every column, each stored contiguously
+	std::vector<int> weights;
+	//The number of times every row occurs (1 unless the row stands for several identical rows)
+	int num_rows;
+	//The number of rows in the table
+	bool unit_weights;
+	//Whether every row has a weight of 1
+	bool sorted;
+	//Whether the codes of every column are in the order of their features
+
+	public:
+	//CONSTRUCTORS
+	EncodedTable(){num_rows=0;sorted=true;unit_weights=true;}
+	EncodedTable(const std::vector<T>& conds){num_rows=0;sorted=true;unit_weights=true;set_conditions(conds);}
+	EncodedTable(const std::vector<T>& conds, const std::vector<std::vector<T> >& data);
+	EncodedTable(const std::vector<T>& conds, const std::vector<SymbolTable<T> >& tables,
+			const std::vector<std::vector<int> >& cols);
+	//Puts together a table from columns that are already encoded (with unit weights)
+
+	//ACCESSORS
+	int rows()const{return num_rows;}
+	int width()const{return columns.size();}
+	//The number of columns in every row
+	int num_conditions()const{return conditions.size()-1;}
+	//The number of conditions a tree may branch on (the outcome is not considered)
+	int outcome_column()const{return columns.size()-1;}
+	const T& condition(int column)const{return conditions[column];}
+	const std::vector<T>& get_conditions()const{return conditions;}
+	int at(int row, int column)const{return columns[column][row];}
+	int weight(int row)const{return weights[row];}
+	const std::vector<int>& get_weights()const{return weights;}
+	bool has_unit_weights()const{return unit_weights;}
+	//Whether every row counts once (so counting rows is the same as adding up their weights)
+	const std::vector<int>& column(int c)const{return columns[c];}
+	const SymbolTable<T>& symbols(int column)const{return symbol_tables[column];}
+	const T& decode(int column, int code)const{return symbol_tables[column].decode(code);}
+	bool is_sorted()const{return sorted;}
+	EncodedTable<T> schema()const;
+	//A copy of the table with its names and symbol tables but none of its rows
+	std::vector<std::vector<int> > encode_query(const std::vector<T>& query)const;
+	//Encodes the features of a query into the codes they have in each condition
+	void encode_query(const std::vector<T>& query, std::vector<std::vector<int> >& encoded)const;
+	//The same, into vectors that are reused from one query to the next
+	EncodedTable<T> select(const std::vector<int>& column_indices, const std::vector<int>& row_indices)const;
+	//A copy of some of the columns (with their symbol tables) for some of the rows, in the order given
+	EncodedTable<T> aggregated()const;
+	//A copy of the table with every set of identical rows collapsed into one row weighted by their number
+
+	//MODIFIERS
+	void set_conditions(const std::vector<T>& conds);
+	//Names the conditions and, while the table is empty, sizes the columns to match
+	void add_row(const std::vector<T>& row, int weight=1);
+	//Encodes a row of features and appends it to the table, counting it "weight" times
+	int encode(int column, const T& feature);
+	//Returns the code of a feature in a column, adding the feature to the column's symbol table if it is new
+	void add_codes(const std::vector<int>& codes, int weight=1);
+	//Appends a row that is already encoded, counting it "weight" times
+	void add_weight(int row, int weight);
+	//Counts a row of the table "weight" more times
+	void append(const EncodedTable<T>& other);
+	//Appends the rows of a table with symbol tables of its own, as if they were added one by one
+	void sort_symbols();
+	//Renumbers the codes of every column in the order of their features
+};
+
+template <class T>
+EncodedTable<T>::EncodedTable(const std::vector<T>& conds, const std::vector<std::vector<T> >& data){
+	num_rows=0;
+	sorted=true;
+	unit_weights=true;
+	set_conditions(conds);
+	for(int i=0;i<data.size();i++){
+		add_row(data[i]);
+	};
+}
+
+template <class T>
+EncodedTable<T>::EncodedTable(const std::vector<T>& conds, const std::vector<SymbolTable<T> >& tables,
+		const std::vector<std::vector<int> >& cols):conditions(conds),symbol_tables(tables),columns(cols){
+	/*The codes are taken as they are, so the table is only sorted if the features of every symbol
+	 * table already are.*/
+	num_rows = columns.empty() ? 0 : columns[0].size();
+	weights.assign(num_rows,1);
+	unit_weights = true;
+	sorted = true;
+	for(int c=0;c<symbol_tables.size();c++){
+		for(int code=1;code<symbol_tables[c].size();code++){
+			if(symbol_tables[c].decode(code) < symbol_tables[c].decode(code-1)){
+				sorted = false;
+			};
+		};
+	};
+}
+
+template <class T>
+EncodedTable<T> EncodedTable<T>::schema()const{
+	EncodedTable<T> ret;
+	ret.conditions = conditions;
+	ret.symbol_tables = symbol_tables;
+	ret.columns.resize(columns.size());
+	ret.sorted = sorted;
+	return ret;
+}
+
+template <class T>
+EncodedTable<T> EncodedTable<T>::select(const std::vector<int>& column_indices,
+		const std::vector<int>& row_indices)const{
+	/*The codes are copied as they are, so nothing has to be encoded again.*/
+	EncodedTable<T> ret;
+	ret.sorted = sorted;
+	for(int c=0;c<column_indices.size();c++){
+		ret.conditions.push_back(conditions[column_indices[c]]);
+		ret.symbol_tables.push_back(symbol_tables[column_indices[c]]);
+		const std::vector<int>& column = columns[column_indices[c]];
+		std::vector<int> selected(row_indices.size());
+		for(int i=0;i<row_indices.size();i++){
+			selected[i] = column[row_indices[i]];
+		};
+		ret.columns.push_back(selected);
+	};
+	for(int i=0;i<row_indices.size();i++){
+		ret.weights.push_back(weights[row_indices[i]]);
+		if(weights[row_indices[i]]!=1){
+			ret.unit_weights = false;
+		};
+	};
+	ret.num_rows = row_indices.size();
+	return ret;
+}
+
+template <class T>
+EncodedTable<T> EncodedTable<T>::aggregated()const{
+	/*Rows are identical when all of their codes are, so the rows are grouped by their codes, in the
+	 * order each group first appears, and the weight of a group is the sum of the weights of its rows.
+	 * The counts of any set of features are the same for both tables, but the aggregated table only
+	 * has as many rows as there are distinct rows.*/
+	EncodedTable<T> ret = schema();
+	std::map<std::vector<int>,int> row_of_codes;
+	std::vector<int> codes(columns.size());
+	for(int i=0;i<num_rows;i++){
+		for(int c=0;c<columns.size();c++){
+			codes[c] = columns[c][i];
+		};
+		std::map<std::vector<int>,int>::iterator itr = row_of_codes.find(codes);
+		if(itr!=row_of_codes.end()){
+			ret.weights[itr->second] += weights[i];
+			continue;
+		};
+		row_of_codes[codes] = ret.num_rows;
+		for(int c=0;c<columns.size();c++){
+			ret.columns[c].push_back(codes[c]);
+		};
+		ret.weights.push_back(weights[i]);
+		ret.num_rows++;
+	};
+	for(int i=0;i<ret.num_rows;i++){
+		if(ret.weights[i]!=1){
+			ret.unit_weights = false;
+		};
+	};
+	return ret;
+}
+
+template <class T>
+std::vector<std::vector<int> > EncodedTable<T>::encode_query(const std::vector<T>& query)const{
+	/*A query is only a list of features, so every feature is looked up in the symbol table of
+	 * every condition. A feature that does not occur in a condition's column simply has no code
+	 * for that condition.*/
+	std::vector<std::vector<int> > encoded;
+	encode_query(query,encoded);
+	return encoded;
+}
+
+template <class T>
+void EncodedTable<T>::encode_query(const std::vector<T>& query, std::vector<std::vector<int> >& encoded)const{
+	encoded.resize(num_conditions());
+	for(int i=0;i<encoded.size();i++){
+		encoded[i].clear();
+		for(int j=0;j<query.size();j++){
+			int code = symbol_tables[i].lookup(query[j]);
+			if(code>=0){
+				encoded[i].push_back(code);
+			};
+		};
+	};
+}
+
+template <class T>
+void EncodedTable<T>::set_conditions(const std::vector<T>& conds){
+	conditions = conds;
+	if(num_rows==0){
+		columns.resize(conds.size());
+		symbol_tables.resize(conds.size());
+	};
+}
+
+template <class T>
+void EncodedTable<T>::add_row(const std::vector<T>& row, int weight){
+	/*The width of the table is the width of its rows, so the first row decides it (the data files
+	 * do not always name every column). Every feature is then encoded by its column's table.*/
+	if(num_rows==0 && row.size()!=columns.size()){
+		columns.resize(row.size());
+		symbol_tables.resize(row.size());
+	};
+	for(int i=0;i<columns.size();i++){
+		columns[i].push_back(encode(i,row[i]));
+	};
+	weights.push_back(weight);
+	if(weight!=1){
+		unit_weights = false;
+	};
+	num_rows++;
+}
+
+template <class T>
+int EncodedTable<T>::encode(int column, const T& feature){
+	int before = symbol_tables[column].size();
+	int code = symbol_tables[column].encode(feature);
+	if(symbol_tables[column].size()!=before && code>0 &&
+			feature < symbol_tables[column].decode(code-1)){
+		//A new feature that sorts before the last one breaks the order of the codes
+		sorted = false;
+	};
+	return code;
+}
+
+template <class T>
+void EncodedTable<T>::add_codes(const std::vector<int>& codes, int weight){
+	for(int i=0;i<columns.size();i++){
+		columns[i].push_back(codes[i]);
+	};
+	weights.push_back(weight);
+	if(weight!=1){
+		unit_weights = false;
+	};
+	num_rows++;
+}
+
+template <class T>
+void EncodedTable<T>::add_weight(int row, int weight){
+	weights[row] += weight;
+	if(weight!=0){
+		unit_weights = false;
+	};
+}
+
+template <class T>
+void EncodedTable<T>::append(const EncodedTable<T>& other){
+	/*The features of every column of the other table are encoded into this table's symbol table in the
+	 * order of their codes, which is the order they first appear in the other table, and the columns are
+	 * then copied through that remapping. The codes (and whether they are sorted) come out the same as if
+	 * the rows had been added one by one, so tables that were encoded in pieces can be put back together.*/
+	if(num_rows==0 && other.width()!=columns.size()){
+		columns.resize(other.width());
+		symbol_tables.resize(other.width());
+	};
+	for(int i=0;i<columns.size();i++){
+		std::vector<int> remap(other.symbol_tables[i].size());
+		for(int code=0;code<remap.size();code++){
+			remap[code] = encode(i,other.symbol_tables[i].decode(code));
+		};
+		const std::vector<int>& other_column = other.columns[i];
+		for(int j=0;j<other.num_rows;j++){
+			columns[i].push_back(remap[other_column[j]]);
+		};
+	};
+	weights.insert(weights.end(),other.weights.begin(),other.weights.end());
+	if(!other.unit_weights){
+		unit_weights = false;
+	};
+	num_rows += other.num_rows;
+}
+
+template <class T>
+void EncodedTable<T>::sort_symbols(){
+	/*Sorting the symbol tables produces a remapping of the codes, which is then applied
+	 * to each column in one pass.*/
+	if(sorted){
+		return;
+	};
+	for(int i=0;i<columns.size();i++){
+		std::vector<int> remap = symbol_tables[i].sort_symbols();
+		for(int j=0;j<columns[i].size();j++){
+			columns[i][j] = remap[columns[i][j]];
+		};
+	};
+	sorted = true;
+}
+
+template <class T>
+class StreamingTable{
+	/*This class takes the rows of a table one at a time, as they arrive from a feed of any length, and
+	 * keeps them the way "aggregated" would: every distinct row is stored once, weighted by the number of
+	 * times it was read. Reading a row only updates the weight of its row (or adds a row the first time it
+	 * is read), so the memory the table takes grows with the number of distinct rows and features rather
+	 * than with the number of rows read. The weights are the counts that a tree takes its certainties from,
+	 * and as every tree makes its own copy of the table it is built on, a tree can be built on "table" at
+	 * any point as a snapshot of the rows read so far while more rows keep arriving.*/
+	private:
+	//MEMBER VARIABLES
+	EncodedTable<T> aggregate;
+	//One weighted row for every distinct row read
+	std::map<std::vector<int>,int> row_of_codes;
+	//The row of "aggregate" of every distinct row, by its codes
+	std::vector<int> codes;
+	//The codes of the row being read
+	long long num_read;
+	//The number of rows read (counting each row as many times as its weight)
+
+	public:
+	//CONSTRUCTORS
+	StreamingTable(const std::vector<T>& conds):aggregate(conds){num_read=0;}
+	//ACCESSORS
+	const EncodedTable<T>& table()const{return aggregate;}
+	//The rows read so far, aggregated
+	long long rows_read()const{return num_read;}
+	int distinct_rows()const{return aggregate.rows();}
+	//MODIFIERS
+	int add_row(const std::vector<T>& row, int weight=1);
+	/*Reads a row that occurs "weight" times, returning the row of "table" that counts it (or -1 for a row
+	 * that is not as wide as the table, which is not read)*/
+};
+
+template <class T>
+int StreamingTable<T>::add_row(const std::vector<T>& row, int weight){
+	/*The first row is simply added, as it decides the width of the table (see EncodedTable::add_row).
+	 * Any later row of another width is left out rather than read into the wrong columns.*/
+	if(aggregate.rows()>0 && row.size()!=aggregate.width()){
+		return -1;
+	};
+	num_read += weight;
+	if(aggregate.rows()==0){
+		aggregate.add_row(row,weight);
+		codes.resize(row.size());
+		for(int i=0;i<row.size();i++){
+			codes[i] = aggregate.at(0,i);
+		};
+		row_of_codes[codes] = 0;
+		return 0;
+	};
+	codes.resize(aggregate.width());
+	for(int i=0;i<codes.size();i++){
+		codes[i] = aggregate.encode(i,row[i]);
+	};
+	std::map<std::vector<int>,int>::iterator itr = row_of_codes.find(codes);
+	if(itr!=row_of_codes.end()){
+		aggregate.add_weight(itr->second,weight);
+		return itr->second;
+	};
+	row_of_codes[codes] = aggregate.rows();
+	aggregate.add_codes(codes,weight);
+	return aggregate.rows()-1;
+}
+#endif
@@ -0,0 +1,133 @@
+#ifndef TABLE_READER_H
+#define TABLE_READER_H
+#include <string>
+#include <string_view>
+#include <vector>
+#include <istream>
+#include "table.h"
+#include "csv_reader.h"
+/*This header file is comprised by a reader for the data files of the lecture and golf examples. Such a
+ * file is a list of words separated by whitespace: the names of the conditions (the last one naming the
+ * outcome) up to the word "quit", then the rows of the table, each with one feature per condition, up to
+ * the word "query" at the start of a row, and then the features of the query. Rather than extracting the
+ * words one at a time from a stream, the file is mapped into memory (or read from a stream in large
+ * blocks) and every word is handed out as a view, so a word is only copied when a row is encoded.*/
+
+class TokenReader{
+	/*This class splits text into the words between its whitespace. The text is either all in memory,
+	 * as a mapped file, or read from a stream in blocks, in which case a word that runs past the end of
+	 * a block is kept until the rest of it is read. A word is a view that is only valid until the next
+	 * word is read.*/
+	private:
+	//MEMBER VARIABLES
+	std::istream* in;
+	//The stream the text is read from (NULL when all of the text is in memory)
+	std::string buffer;
+	//The block of the stream that is being read
+	std::string_view text;
+	size_t position;
+	//Where the next word starts looking
+	static const size_t BLOCK_SIZE = 1<<16;
+
+	//UTILITIES
+	static bool is_space(char c){return c==' ' || c=='\n' || c=='\t' || c=='\r' || c=='\v' || c=='\f';}
+	bool refill();
+	//Reads the next block of the stream after what is left of the current one (false at the end)
+
+	public:
+	//CONSTRUCTORS
+	TokenReader(std::string_view t){in=NULL;text=t;position=0;}
+	TokenReader(std::istream& stream){in=&stream;position=0;}
+	//MODIFIERS
+	bool next(std::string_view& word);
+	//Reads the next word (false at the end of the text)
+};
+
+inline bool TokenReader::refill(){
+	if(in==NULL || !*in){
+		return false;
+	};
+	buffer.erase(0,position);
+	position = 0;
+	size_t before = buffer.size();
+	buffer.resize(before+BLOCK_SIZE);
+	in->read(&buffer[before],BLOCK_SIZE);
+	buffer.resize(before+in->gcount());
+	text = buffer;
+	return in->gcount()>0;
+}
+
+inline bool TokenReader::next(std::string_view& word){
+	while(true){
+		while(position<text.size() && is_space(text[position])){
+			position++;
+		};
+		if(position==text.size()){
+			if(!refill()){
+				return false;
+			};
+			continue;
+		};
+		size_t end = position;
+		while(end<text.size() && !is_space(text[end])){
+			end++;
+		};
+		size_t length = end-position;
+		//a word that reaches the end of a block may go on in the next one
+		if(end==text.size() && refill()){
+			continue;
+		};
+		//a refill that reads nothing may still have moved the word to the start of the buffer
+		word = text.substr(position,length);
+		position += length;
+		return true;
+	};
+}
+
+inline std::vector<std::string> read_conditions(TokenReader& reader){
+	//Reads the names of the conditions, up to the word "quit"
+	std::vector<std::string> conditions;
+	std::string_view word;
+	while(reader.next(word) && word!="quit"){
+		conditions.push_back(std::string(word));
+	};
+	return conditions;
+}
+
+template <class Handler>
+int read_rows(TokenReader& reader, int width, Handler add_row){
+	/*Reads the rows of the table, up to the word "query" at the start of a row, and hands every row to
+	 * "add_row" (such as the "add_row" of an EncodedTable or a StreamingTable) as it is read. The strings
+	 * of the row are reused, so a row only allocates for features that are longer than before. A row
+	 * that is cut short by the end of the text is not handed on. Returns the number of rows read.*/
+	std::vector<std::string> row(width);
+	std::string_view word;
+	int num_rows = 0;
+	while(width>0 && reader.next(word)){
+		if(word=="query"){
+			break;
+		};
+		row[0].assign(word.data(),word.size());
+		int i = 1;
+		for(;i<width && reader.next(word);i++){
+			row[i].assign(word.data(),word.size());
+		};
+		if(i<width){
+			break;
+		};
+		add_row(row);
+		num_rows++;
+	};
+	return num_rows;
+}
+
+inline std::vector<std::string> read_query(TokenReader& reader){
+	//Reads the features of the query, which is the rest of the text
+	std::vector<std::string> query;
+	std::string_view word;
+	while(reader.next(word)){
+		query.push_back(std::string(word));
+	};
+	return query;
+}
+#endif
@@ -0,0 +1,94 @@
+#include "../Euros/tree.h"
+#include <random>
+#include <sstream>
+#include <iostream>
+/*Builds the same trees serially and on a work-stealing pool, with a serial cutoff low enough that
+ * nearly every subtree is handed to the pool and stolen. A parallel build must come out with the same
+ * size and the same paths, in the same order, as a serial one, for every counting mode, for lattices,
+ * and for a tree that is built from inside a task of another pool (whose workers must not be taken for
+ * workers of the tree's pool). run_tests.sh runs this test under ThreadSanitizer as well, which catches
+ * workers that share memory they should not.*/
+
+std::vector<std::vector<std::string> > random_rows(std::mt19937& rng, int width, int num_rows){
+	//Rows of three features per condition and an outcome out of three
+	std::vector<std::vector<std::string> > rows;
+	for(int i=0;i<num_rows;i++){
+		std::vector<std::string> row;
+		for(int c=0;c<width;c++){
+			row.push_back(std::string(1,'a'+c)+std::to_string(rng()%3));
+		};
+		rows.push_back(row);
+	};
+	return rows;
+}
+
+std::string all_paths(const DecisionTree<std::string>& tree){
+	std::ostringstream paths;
+	tree.print_all_paths(paths);
+	return paths.str();
+}
+
+int compare(const DecisionTree<std::string>& serial, const DecisionTree<std::string>& parallel,
+		const std::string& what){
+	//Returns the number of ways in which the trees differ, printing each of them
+	int failures = 0;
+	if(serial.get_size()!=parallel.get_size()){
+		std::cout << "parallel_build: " << what << " has " << parallel.get_size() << " nodes rather than "
+			<< serial.get_size() << "\n";
+		failures++;
+	};
+	if(all_paths(serial)!=all_paths(parallel)){
+		std::cout << "parallel_build: " << what << " prints different paths\n";
+		failures++;
+	};
+	return failures;
+}
+
+int main(){
+	std::mt19937 rng(11);
+	int width = 6;
+	std::vector<std::string> conditions;
+	for(int c=0;c<width;c++){
+		conditions.push_back("C"+std::to_string(c));
+	};
+	std::vector<std::vector<std::string> > rows = random_rows(rng,width,300);
+	int failures = 0;
+	for(int mode=SCAN_ROWS;mode<=CONTINGENCY_CUBE;mode++){
+		for(int lattice=0;lattice<2;lattice++){
+			TreeOptions options;
+			options.counting = (CountingMode)mode;
+			options.share_permutations = lattice;
+			DecisionTree<std::string> serial(conditions,rows,0,2,0.99,options);
+			for(int run=0;run<2;run++){
+				options.threads = 4;
+				options.serial_cutoff = 1;
+				DecisionTree<std::string> parallel(conditions,rows,0,2,0.99,options);
+				failures += compare(serial,parallel,"the " + std::string(lattice ? "lattice" : "tree") +
+						" of counting mode " + std::to_string(mode) + " built on 4 threads");
+			};
+		};
+	};
+	//the outer pool has more workers than the tree's, so a worker index of the wrong pool is out of range
+	TreeOptions options;
+	DecisionTree<std::string> serial(conditions,rows,0,2,0.99,options);
+	options.threads = 2;
+	options.serial_cutoff = 1;
+	std::vector<int> nested_failures(8,0);
+	{
+		WorkStealingPool outer(8);
+		for(int k=0;k<nested_failures.size();k++){
+			outer.submit([&,k](){
+				DecisionTree<std::string> parallel(conditions,rows,0,2,0.99,options);
+				nested_failures[k] = compare(serial,parallel,"a tree built inside another pool");
+			});
+		};
+		outer.wait();
+	}
+	for(int k=0;k<nested_failures.size();k++){
+		failures += nested_failures[k];
+	};
+	if(failures==0){
+		std::cout << "parallel_build: passed\n";
+	};
+	return failures==0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "../Euros/tree.h"
+#include <random>
+#include <cstdlib>
+#include <new>
+#include <iostream>
+/*Counts the heap allocations of queries once they have run before. The search of a query keeps its
+ * memory from one query to the next, so a query that is asked again may only allocate the result it
+ * hands back: one block for its list of paths and one for the features of every path (the names are
+ * short enough to be kept inside the strings themselves). Trees, lattices, lazy trees and frozen trees
+ * are all checked.*/
+
+static long allocations = 0;
+static bool counting = false;
+
+void* operator new(size_t size){
+	if(counting){
+		allocations++;
+	};
+	void* p = std::malloc(size ? size : 1);
+	if(!p){
+		throw std::bad_alloc();
+	};
+	return p;
+}
+void* operator new[](size_t size){return operator new(size);}
+void* operator new(size_t size, std::align_val_t alignment){
+	if(counting){
+		allocations++;
+	};
+	void* p = std::aligned_alloc((size_t)alignment,(size+(size_t)alignment-1)/(size_t)alignment*(size_t)alignment);
+	if(!p){
+		throw std::bad_alloc();
+	};
+	return p;
+}
+void* operator new[](size_t size, std::align_val_t alignment){return operator new(size,alignment);}
+void operator delete(void* p)noexcept{std::free(p);}
+void operator delete[](void* p)noexcept{std::free(p);}
+void operator delete(void* p, size_t)noexcept{std::free(p);}
+void operator delete[](void* p, size_t)noexcept{std::free(p);}
+void operator delete(void* p, std::align_val_t)noexcept{std::free(p);}
+void operator delete[](void* p, std::align_val_t)noexcept{std::free(p);}
+void operator delete(void* p, size_t, std::align_val_t)noexcept{std::free(p);}
+void operator delete[](void* p, size_t, std::align_val_t)noexcept{std::free(p);}
+
+long result_allocations(const QueryResult<std::string>& result){
+	//The blocks that the result itself holds
+	long blocks = result.paths.empty() ? 0 : 1;
+	for(int i=0;i<result.paths.size();i++){
+		if(!result.paths[i].features.empty()){
+			blocks++;
+		};
+	};
+	return blocks;
+}
+
+template <class Tree>
+int check_queries(const Tree& tree, const std::vector<std::vector<std::string> >& queries, const std::string& what){
+	//Asks every query once to warm up and then again, counting what the second round allocates
+	for(int i=0;i<queries.size();i++){
+		tree.query(queries[i]);
+	};
+	int failures = 0;
+	int matched = 0;
+	for(int i=0;i<queries.size();i++){
+		allocations = 0;
+		counting = true;
+		QueryResult<std::string> result = tree.query(queries[i]);
+		counting = false;
+		matched += result.matched;
+		if(allocations!=result_allocations(result)){
+			std::cout << "query_allocations: a query of " << what << " made " << allocations
+				<< " allocations, of which " << result_allocations(result) << " are its result\n";
+			failures++;
+		};
+	};
+	if(matched==0){
+		std::cout << "query_allocations: no query of " << what << " matched a path\n";
+		failures++;
+	};
+	return failures;
+}
+
+int main(){
+	std::mt19937 rng(23);
+	int width = 6;
+	std::vector<std::string> conditions;
+	for(int c=0;c<width;c++){
+		conditions.push_back("C"+std::to_string(c));
+	};
+	std::vector<std::vector<std::string> > rows;
+	for(int i=0;i<300;i++){
+		std::vector<std::string> row;
+		for(int c=0;c<width;c++){
+			row.push_back(std::string(1,'a'+c)+std::to_string(rng()%3));
+		};
+		rows.push_back(row);
+	};
+	std::vector<std::vector<std::string> > queries;
+	for(int i=0;i<50;i++){
+		//queries of one or more features per condition, so that some of them tie
+		std::vector<std::string> query;
+		for(int c=0;c<width-1;c++){
+			for(int feature=0;feature<3;feature++){
+				if(rng()%3==0){
+					query.push_back(std::string(1,'a'+c)+std::to_string(feature));
+				};
+			};
+		};
+		queries.push_back(query);
+	};
+	int failures = 0;
+	for(int kind=0;kind<3;kind++){
+		TreeOptions options;
+		options.share_permutations = kind==1;
+		options.lazy = kind==2;
+		DecisionTree<std::string> tree(conditions,rows,0,2,0.99,options);
+		std::string what = kind==0 ? "a tree" : kind==1 ? "a lattice" : "a lazy tree";
+		failures += check_queries(tree,queries,what);
+		if(kind==0){
+			FrozenDecisionTree<std::string> frozen = tree.freeze();
+			failures += check_queries(frozen,queries,"a frozen tree");
+		};
+	};
+	if(failures==0){
+		std::cout << "query_allocations: passed\n";
+	};
+	return failures==0 ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+#!/bin/sh
+#Builds and runs every test in this folder ("CXX" picks the compiler, g++ by default). Every test is a
+#program of its own that prints what went wrong and exits with 1 if it failed.
+cd "$(dirname "$0")"
+CXX=${CXX:-g++}
+failed=0
+for test in *.cpp; do
+	name=${test%.cpp}
+	if ! $CXX -std=c++17 -O2 -pthread -o "$name.out" "$test" || ! ./"$name.out"; then
+		echo "FAILED: $name"
+		failed=1
+	fi
+done
+#the parallel build is run under ThreadSanitizer as well, where the compiler has it
+if $CXX -std=c++17 -O1 -g -fsanitize=thread -pthread -o parallel_build_tsan.out parallel_build.cpp 2>/dev/null; then
+	if ! TSAN_OPTIONS=halt_on_error=1 ./parallel_build_tsan.out; then
+		echo "FAILED: parallel_build under ThreadSanitizer"
+		failed=1
+	fi
+fi
+exit $failed
@@ -0,0 +1,65 @@
+#include "../Euros/table.h"
+#include <random>
+#include <iostream>
+/*Streams rows into a StreamingTable, with rows that are a column short or a column too long mixed in
+ * among them. Those rows must be turned away (add_row returns -1) without being counted, and the table
+ * must come out the same as the aggregated table of the rows of the right width alone.*/
+
+int main(){
+	std::mt19937 rng(18);
+	int width = 4;
+	std::vector<std::string> conditions;
+	for(int c=0;c<width;c++){
+		conditions.push_back("C"+std::to_string(c));
+	};
+	StreamingTable<std::string> streaming(conditions);
+	std::vector<std::vector<std::string> > kept;
+	int failures = 0;
+	for(int i=0;i<500;i++){
+		std::vector<std::string> row;
+		int row_width = i==0 ? width : width-1+rng()%3;
+		for(int c=0;c<row_width;c++){
+			row.push_back(std::string(1,'a'+c)+std::to_string(rng()%3));
+		};
+		int found = streaming.add_row(row);
+		if(row_width==width){
+			kept.push_back(row);
+			if(found<0 || found>=streaming.distinct_rows()){
+				std::cout << "streaming_table: a row of the right width was counted in row " << found << "\n";
+				failures++;
+			};
+		}
+		else if(found!=-1){
+			std::cout << "streaming_table: a row of " << row_width << " features was counted in row " << found
+				<< " of a table " << width << " wide\n";
+			failures++;
+		};
+	};
+	EncodedTable<std::string> expected = EncodedTable<std::string>(conditions,kept).aggregated();
+	const EncodedTable<std::string>& table = streaming.table();
+	if(streaming.rows_read()!=kept.size()){
+		std::cout << "streaming_table: " << streaming.rows_read() << " rows read rather than " << kept.size() << "\n";
+		failures++;
+	};
+	if(table.width()!=width || table.rows()!=expected.rows()){
+		std::cout << "streaming_table: the table has " << table.rows() << " rows of " << table.width()
+			<< " columns rather than " << expected.rows() << " of " << width << "\n";
+		failures++;
+	}
+	else{
+		for(int r=0;r<table.rows();r++){
+			bool same = table.weight(r)==expected.weight(r);
+			for(int c=0;c<width && same;c++){
+				same = table.decode(c,table.at(r,c))==expected.decode(c,expected.at(r,c));
+			};
+			if(!same){
+				std::cout << "streaming_table: row " << r << " differs from the aggregated table\n";
+				failures++;
+			};
+		};
+	};
+	if(failures==0){
+		std::cout << "streaming_table: passed\n";
+	};
+	return failures==0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include "../SimpleGolf/table_reader.h"
+#include <sstream>
+#include <iostream>
+/*Reads text from a stream with a TokenReader and checks that it finds the same words as extracting
+ * them from the stream one at a time, for text whose words end on, just before and just after the
+ * 65,536 characters of a block (with and without whitespace at the end), so that words that run from
+ * one block into the next and words that end the stream right at the end of a block are both read.*/
+
+std::string words_of_length(int length, bool trailing_space){
+	//Words of a few letters up to "length" characters, the last of them ending the text unless there is a space after it
+	std::string text;
+	for(int i=0;text.size()<length;i++){
+		std::string word(1+i%7,'a'+i%26);
+		if(text.size()+word.size()+1>length){
+			word.assign(length-text.size(),'z');
+		}
+		else{
+			word += i%3 ? " " : "\n";
+		};
+		text += word;
+	};
+	if(trailing_space && text.back()!=' ' && text.back()!='\n'){
+		text += " ";
+	};
+	return text;
+}
+
+int main(){
+	int failures = 0;
+	const int block = 1<<16;
+	for(int length=block-3;length<=block+3;length++){
+		for(int trailing=0;trailing<2;trailing++){
+			std::string text = words_of_length(length,trailing);
+			std::istringstream expected_stream(text);
+			std::vector<std::string> expected;
+			std::string extracted;
+			while(expected_stream >> extracted){
+				expected.push_back(extracted);
+			};
+			std::istringstream stream(text);
+			TokenReader reader(stream);
+			std::vector<std::string> found;
+			std::string_view word;
+			try{
+				while(reader.next(word)){
+					found.push_back(std::string(word));
+				};
+			}
+			catch(const std::exception& e){
+				std::cout << "token_reader: reading " << text.size() << " characters threw " << e.what() << "\n";
+				failures++;
+				continue;
+			};
+			if(found!=expected){
+				std::cout << "token_reader: " << found.size() << " words read from " << text.size()
+					<< " characters rather than " << expected.size() << "\n";
+				failures++;
+			};
+		};
+	};
+	if(failures==0){
+		std::cout << "token_reader: passed\n";
+	};
+	return failures==0 ? 0 : 1;
+}